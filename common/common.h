@@ -12,6 +12,7 @@
 #include <fcntl.h>
 #include <filesystem>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <span>
@@ -79,7 +80,10 @@ using namespace std::literals::string_view_literals;
 
 template <typename Context> class OutputFile;
 
-inline char *output_tmpfile;
+// Temporary output files that have to be removed if we exit abnormally.
+// There are at most two of them: the main output and the debug info
+// file for --separate-debug-file.
+inline char *output_tmpfiles[2];
 inline thread_local bool opt_demangle;
 
 inline u8 *output_buffer_start = nullptr;
@@ -546,6 +550,96 @@ private:
   static constexpr const char *marker = "marker";
 };
 
+//
+// Arena
+//
+
+// Arena is a per-thread bump allocator for objects that live until the
+// end of the process. Each thread allocates objects from its own memory
+// block, so allocation is lock-free and objects created by the same
+// thread are placed next to each other.
+//
+// Memory is released in bulk when the arena itself is destroyed. No
+// destructor is run, so there is no per-object teardown at exit.
+class Arena {
+public:
+  Arena() = default;
+  Arena(const Arena &) = delete;
+
+  // Objects in an arena are never destructed. Memory is released in
+  // bulk when the arena is destroyed, so only trivially-destructible
+  // types can be allocated. Use make_span() instead of std::vector for
+  // arrays owned by such objects.
+  template <typename T, typename... Args>
+  T *make(Args &&...args) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  template <typename T>
+  std::span<T> make_span(i64 n) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    T *p = (T *)alloc(sizeof(T) * n, alignof(T));
+    std::uninitialized_value_construct_n(p, n);
+    return {p, (size_t)n};
+  }
+
+  template <typename T>
+  std::span<T> make_span(std::span<const T> vec) {
+    std::span<T> span = make_span<T>(vec.size());
+    std::copy(vec.begin(), vec.end(), span.begin());
+    return span;
+  }
+
+  void *alloc(i64 size, i64 align) {
+    assert(has_single_bit(align));
+    Local &x = locals.local();
+
+    u8 *p = (u8 *)align_to((u64)x.cur, align);
+    if (p + size > x.end) {
+      i64 sz = std::max<i64>(size + align, BLOCK_SIZE);
+      x.blocks.emplace_back(new u8[sz]);
+      x.capacity += sz;
+      x.cur = x.blocks.back().get();
+      x.end = x.cur + sz;
+      p = (u8 *)align_to((u64)x.cur, align);
+    }
+
+    x.cur = p + size;
+    x.size += size;
+    return p;
+  }
+
+  // Returns the number of bytes handed out to callers.
+  i64 get_size() {
+    i64 sum = 0;
+    for (Local &x : locals)
+      sum += x.size;
+    return sum;
+  }
+
+  // Returns the number of bytes allocated from the system.
+  i64 get_capacity() {
+    i64 sum = 0;
+    for (Local &x : locals)
+      sum += x.capacity;
+    return sum;
+  }
+
+private:
+  static constexpr i64 BLOCK_SIZE = 1024 * 1024;
+
+  struct Local {
+    std::vector<std::unique_ptr<u8[]>> blocks;
+    u8 *cur = nullptr;
+    u8 *end = nullptr;
+    i64 size = 0;
+    i64 capacity = 0;
+  };
+
+  tbb::enumerable_thread_specific<Local> locals;
+};
+
 //
 // output-file.h
 //
@@ -619,6 +713,8 @@ private:
   static bool do_match(std::string_view str, std::span<Element> elements);
 
   std::vector<Element> elements;
+
+  friend class MultiGlob;
 };
 
 //
@@ -638,13 +734,45 @@ private:
     std::unique_ptr<TrieNode> children[256];
   };
 
+  // Complex glob patterns are converted to a single NFA. Each pattern
+  // occupies a consecutive range of NFA states followed by an ACCEPT
+  // state.
+  struct NfaState {
+    enum { CHAR, STAR, ACCEPT } kind;
+    std::bitset<256> chars;
+    u32 value = -1;
+  };
+
+  // The NFA is lazily converted to a DFA as we match strings. `next`
+  // is DFA_UNKNOWN until the transition is computed for the first time.
+  struct DfaState {
+    std::vector<u32> nfa_states;
+    u32 value = -1;
+    std::atomic<i32> next[256];
+  };
+
+  static constexpr i32 DFA_DEAD = -1;
+  static constexpr i32 DFA_UNKNOWN = -2;
+  static constexpr i32 DFA_FULL = -3;
+  static constexpr i64 DFA_MAX_STATES = 4096;
+
   void compile();
   void fix_suffix_links(TrieNode &node);
   void fix_values();
 
+  std::vector<u32> closure(std::vector<u32> set);
+  std::vector<u32> step(std::span<u32> set, u8 c);
+  u32 get_value(std::span<u32> set);
+  i32 get_dfa_state(std::vector<u32> set);
+  i32 get_next(i32 state, u8 c);
+
   std::vector<std::string> strings;
   std::unique_ptr<TrieNode> root;
-  std::vector<std::pair<Glob, u32>> globs;
+  std::vector<NfaState> nfa;
+  std::vector<u32> nfa_start;
+  tbb::concurrent_vector<std::unique_ptr<DfaState>> dfa;
+  std::map<std::vector<u32>, i32> dfa_map;
+  std::mutex mu;
   std::once_flag once;
   bool is_compiled = false;
 };
@@ -904,6 +1032,19 @@ MappedFile<Context> *MappedFile<Context>::open(Context &ctx, std::string path) {
     if (!mf->data)
       Fatal(ctx) << path << ": MapViewOfFile failed: " << GetLastError();
 #else
+    // Input files are read by parser threads in a random order, so
+    // without a hint, we would stall on synchronous page faults if the
+    // files are not in the page cache. We ask the kernel to start
+    // reading the file in the background as soon as we open it, so that
+    // I/O overlaps with parsing of other files.
+    //
+    // Note that we don't use MAP_POPULATE. The mapping is private and
+    // writable, so populating it would copy every page into anonymous
+    // memory, and mmap would block until the whole file is read.
+#ifdef POSIX_FADV_WILLNEED
+    posix_fadvise(fd, 0, st.st_size, POSIX_FADV_WILLNEED);
+#endif
+
     mf->data = (u8 *)mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
                           MAP_PRIVATE, fd, 0);
     if (mf->data == MAP_FAILED)
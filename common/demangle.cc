@@ -1,6 +1,7 @@
 #include "common.h"
 
 #include <cstdlib>
+#include <tbb/concurrent_hash_map.h>
 
 #ifndef _WIN32
 #include <cxxabi.h>
@@ -10,25 +11,42 @@
 
 namespace mold {
 
-std::string_view demangle(std::string_view name) {
-  static thread_local char *p;
-  if (p)
-    free(p);
-
-  // Try to demangle as a Rust symbol. Since legacy-style Rust symbols
-  // are also valid as a C++ mangled name, we need to call this before
-  // cpp_demangle.
-  p = rust_demangle(std::string(name).c_str(), 0);
-  if (p)
-    return p;
-
-  // Try to demangle as a C++ symbol.
-  if (std::optional<std::string_view> s = cpp_demangle(name))
-    return *s;
-  return name;
+// The same symbol is often demangled many times, e.g. for error
+// messages, map files and version script matching, and demangling is
+// not cheap. So we memoize the results. Demangled strings as well as
+// keys are copied to memory that is never freed, so returned
+// string_views are valid until the process exits.
+using DemangleCache =
+  tbb::concurrent_hash_map<std::string_view, std::optional<std::string_view>,
+                           HashCmp>;
+
+static std::string_view save(std::string_view str) {
+  char *p = (char *)malloc(str.size() + 1);
+  memcpy(p, str.data(), str.size());
+  p[str.size()] = '\0';
+  return {p, str.size()};
 }
 
-std::optional<std::string_view> cpp_demangle(std::string_view name) {
+template <typename Fn>
+static std::optional<std::string_view>
+lookup(DemangleCache &cache, std::string_view name, Fn fn) {
+  {
+    DemangleCache::const_accessor acc;
+    if (cache.find(acc, name))
+      return acc->second;
+  }
+
+  std::optional<std::string_view> val = fn();
+  if (val)
+    val = save(*val);
+
+  DemangleCache::accessor acc;
+  if (cache.insert(acc, save(name)))
+    acc->second = val;
+  return acc->second;
+}
+
+static std::optional<std::string_view> do_cpp_demangle(std::string_view name) {
   static thread_local char *buf;
   static thread_local size_t buflen;
 
@@ -48,4 +66,41 @@ std::optional<std::string_view> cpp_demangle(std::string_view name) {
   return {};
 }
 
+std::string_view demangle(std::string_view name) {
+  static DemangleCache cache;
+
+  // Only C++ (_Z) and Rust (_R and legacy _Z) symbols can be demangled.
+  // Don't pollute the cache with the rest.
+  if (!name.starts_with("_Z") && !name.starts_with("_R"))
+    return name;
+
+  std::optional<std::string_view> val = lookup(cache, name, [&] {
+    // Try to demangle as a Rust symbol. Since legacy-style Rust symbols
+    // are also valid as a C++ mangled name, we need to call this before
+    // cpp_demangle.
+    static thread_local char *p;
+    if (p)
+      free(p);
+
+    p = rust_demangle(std::string(name).c_str(), 0);
+    if (p)
+      return std::optional<std::string_view>(p);
+
+    // Try to demangle as a C++ symbol.
+    return do_cpp_demangle(name);
+  });
+
+  return val ? *val : name;
+}
+
+std::optional<std::string_view> cpp_demangle(std::string_view name) {
+  static DemangleCache cache;
+
+  // Only mangled names can be demangled. Don't pollute the cache
+  // with the rest.
+  if (!name.starts_with("_Z"))
+    return {};
+  return lookup(cache, name, [&] { return do_cpp_demangle(name); });
+}
+
 } // namespace mold
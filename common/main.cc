@@ -35,8 +35,9 @@ static std::string get_mold_version() {
 }
 
 void cleanup() {
-  if (output_tmpfile)
-    unlink(output_tmpfile);
+  for (char *path : output_tmpfiles)
+    if (path)
+      unlink(path);
 }
 
 std::string errno_string() {
@@ -13,9 +13,11 @@
 // of symbol strings.
 //
 // Aho-Corasick cannot handle complex patterns such as `*foo*bar*`.
-// We handle such patterns with the Glob class. Glob is relatively
-// slow, but complex patterns are rare in practice, so it should be
-// OK.
+// We compile all such patterns into a single NFA and convert it to a
+// DFA lazily as we match strings against it. Therefore, matching a
+// string takes time linear to the string length regardless of the
+// number of patterns once the DFA is warmed up. If the DFA grows too
+// large, we fall back to simulating the NFA directly.
 
 #include "common.h"
 
@@ -53,9 +55,27 @@ std::optional<u32> MultiGlob::find(std::string_view str) {
   }
 
   // Match against complex glob patterns
-  for (std::pair<Glob, u32> &glob : globs)
-    if (glob.first.match(str))
-      val = std::min(val, glob.second);
+  if (!dfa.empty()) {
+    i32 state = 0;
+    i32 next = 0;
+    i64 i = 0;
+
+    for (; i < str.size(); i++) {
+      next = get_next(state, str[i]);
+      if (next < 0)
+        break;
+      state = next;
+    }
+
+    if (i == str.size()) {
+      val = std::min(val, dfa[state]->value);
+    } else if (next == DFA_FULL) {
+      std::vector<u32> set = dfa[state]->nfa_states;
+      for (; i < str.size() && !set.empty(); i++)
+        set = step(set, str[i]);
+      val = std::min(val, get_value(set));
+    }
+  }
 
   if (val == UINT32_MAX)
     return {};
@@ -90,11 +110,35 @@ bool MultiGlob::add(std::string_view pat, u32 val) {
 
   // Complex glob pattern
   if (!is_simple_pattern(pat)) {
-    if (std::optional<Glob> glob = Glob::compile(pat)) {
-      globs.push_back({std::move(*glob), val});
-      return true;
+    std::optional<Glob> glob = Glob::compile(pat);
+    if (!glob)
+      return false;
+
+    nfa_start.push_back(nfa.size());
+
+    for (Glob::Element &elem : glob->elements) {
+      switch (elem.kind) {
+      case Glob::STRING:
+        for (u8 c : elem.str) {
+          nfa.push_back({NfaState::CHAR});
+          nfa.back().chars[c] = true;
+        }
+        break;
+      case Glob::STAR:
+        nfa.push_back({NfaState::STAR});
+        break;
+      case Glob::QUESTION:
+        nfa.push_back({NfaState::CHAR});
+        nfa.back().chars.set();
+        break;
+      case Glob::BRACKET:
+        nfa.push_back({NfaState::CHAR, elem.bitset});
+        break;
+      }
     }
-    return false;
+
+    nfa.push_back({NfaState::ACCEPT, {}, val});
+    return true;
   }
 
   // Simple glob pattern
@@ -118,6 +162,87 @@ void MultiGlob::compile() {
     fix_suffix_links(*root);
     fix_values();
   }
+
+  if (!nfa.empty()) {
+    [[maybe_unused]] i32 start = get_dfa_state(closure(nfa_start));
+    assert(start == 0);
+  }
+}
+
+// Returns a sorted set of NFA states reachable from a given set
+// without consuming any input character.
+std::vector<u32> MultiGlob::closure(std::vector<u32> set) {
+  for (i64 i = 0; i < set.size(); i++)
+    if (nfa[set[i]].kind == NfaState::STAR)
+      set.push_back(set[i] + 1);
+
+  sort(set);
+  remove_duplicates(set);
+  return set;
+}
+
+std::vector<u32> MultiGlob::step(std::span<u32> set, u8 c) {
+  std::vector<u32> vec;
+  for (u32 idx : set) {
+    NfaState &s = nfa[idx];
+    if (s.kind == NfaState::STAR)
+      vec.push_back(idx);
+    else if (s.kind == NfaState::CHAR && s.chars[c])
+      vec.push_back(idx + 1);
+  }
+  return closure(std::move(vec));
+}
+
+u32 MultiGlob::get_value(std::span<u32> set) {
+  u32 val = UINT32_MAX;
+  for (u32 idx : set)
+    if (nfa[idx].kind == NfaState::ACCEPT)
+      val = std::min(val, nfa[idx].value);
+  return val;
+}
+
+// Returns the DFA state for a given set of NFA states, creating a new
+// one if it does not exist yet. Must be called with `mu` held unless
+// we are in compile().
+i32 MultiGlob::get_dfa_state(std::vector<u32> set) {
+  if (set.empty())
+    return DFA_DEAD;
+
+  auto it = dfa_map.find(set);
+  if (it != dfa_map.end())
+    return it->second;
+
+  if (dfa.size() >= DFA_MAX_STATES)
+    return DFA_FULL;
+
+  std::unique_ptr<DfaState> state(new DfaState);
+  state->value = get_value(set);
+  for (std::atomic<i32> &next : state->next)
+    next = DFA_UNKNOWN;
+  state->nfa_states = set;
+
+  i32 idx = dfa.size();
+  dfa.push_back(std::move(state));
+  dfa_map.insert({std::move(set), idx});
+  return idx;
+}
+
+i32 MultiGlob::get_next(i32 state, u8 c) {
+  DfaState &s = *dfa[state];
+  i32 next = s.next[c].load(std::memory_order_acquire);
+  if (next != DFA_UNKNOWN)
+    return next;
+
+  std::scoped_lock lock(mu);
+  next = s.next[c].load(std::memory_order_relaxed);
+  if (next == DFA_UNKNOWN) {
+    // If the DFA is full, we store DFA_FULL so that we won't retry
+    // creating a new state for this transition. The caller falls back
+    // to NFA simulation for the rest of the string.
+    next = get_dfa_state(step(s.nfa_states, c));
+    s.next[c].store(next, std::memory_order_release);
+  }
+  return next;
 }
 
 void MultiGlob::fix_suffix_links(TrieNode &node) {
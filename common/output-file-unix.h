@@ -53,7 +53,7 @@ public:
   MemoryMappedOutputFile(Context &ctx, std::string path, i64 filesize, i64 perm)
     : OutputFile<Context>(path, filesize, true) {
     i64 fd;
-    std::tie(fd, output_tmpfile) = open_or_create_file(ctx, path, filesize, perm);
+    std::tie(fd, tmpfile) = open_or_create_file(ctx, path, filesize, perm);
 
     this->buf = (u8 *)mmap(nullptr, filesize, PROT_READ | PROT_WRITE,
                            MAP_SHARED, fd, 0);
@@ -61,8 +61,17 @@ public:
       Fatal(ctx) << path << ": mmap failed: " << errno_string();
     ::close(fd);
 
-    mold::output_buffer_start = this->buf;
-    mold::output_buffer_end = this->buf + filesize;
+    // Register the temporary file so that it is removed on abnormal
+    // exit. The first output file is the main output, and the signal
+    // handler treats a fault in its buffer as a disk full error.
+    if (!output_tmpfiles[0]) {
+      output_tmpfiles[0] = tmpfile;
+      mold::output_buffer_start = this->buf;
+      mold::output_buffer_end = this->buf + filesize;
+    } else {
+      assert(!output_tmpfiles[1]);
+      output_tmpfiles[1] = tmpfile;
+    }
   }
 
   ~MemoryMappedOutputFile() {
@@ -83,12 +92,16 @@ public:
     if (fd2 != -1)
       unlink(this->path.c_str());
 
-    if (rename(output_tmpfile, this->path.c_str()) == -1)
+    if (rename(tmpfile, this->path.c_str()) == -1)
       Fatal(ctx) << this->path << ": rename failed: " << errno_string();
-    output_tmpfile = nullptr;
+    for (char *&path : output_tmpfiles)
+      if (path == tmpfile)
+        path = nullptr;
+    tmpfile = nullptr;
   }
 
 private:
+  char *tmpfile = nullptr;
   int fd2 = -1;
 };
 
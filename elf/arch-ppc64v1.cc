@@ -486,9 +486,9 @@ void RangeExtensionThunk<E>::copy_buf(Context<E> &ctx) {
 }
 
 static InputSection<E> *get_opd_section(ObjectFile<E> &file) {
-  for (std::unique_ptr<InputSection<E>> &isec : file.sections)
+  for (InputSection<E> *isec : file.sections)
     if (isec && isec->name() == ".opd")
-      return isec.get();
+      return isec;
   return nullptr;
 }
 
@@ -602,8 +602,8 @@ void ppc64v1_rewrite_opd(Context<E> &ctx) {
     sort(opd_syms);
 
     // Rewrite relocations so that they directly refer to .opd.
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
-      if (!isec || !isec->is_alive || isec.get() == opd)
+    for (InputSection<E> *isec : file->sections) {
+      if (!isec || !isec->is_alive || isec == opd)
         continue;
 
       for (ElfRel<E> &r : isec->get_rels(ctx)) {
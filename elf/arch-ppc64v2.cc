@@ -179,6 +179,124 @@ static u64 get_local_entry_offset(Context<E> &ctx, Symbol<E> &sym) {
   return 1 << val;
 }
 
+// `pld rX, foo@got@pcrel` can be rewritten to `pla rX, foo@pcrel`
+// if the address of foo is a link-time constant. If relaxed, we don't
+// need to create a GOT entry for foo.
+static bool can_relax_got_pcrel34(Context<E> &ctx, Symbol<E> &sym, u8 *loc) {
+  if (!ctx.arg.relax || sym.is_imported || sym.is_ifunc() || sym.is_absolute())
+    return false;
+
+  // Make sure that the instruction is `pld`
+  u32 prefix = *(ul32 *)loc;
+  u32 suffix = *(ul32 *)(loc + 4);
+  return (prefix & 0xfff0'0000) == 0x0410'0000 && (suffix >> 26) == 57;
+}
+
+// R_PPC64_PCREL_OPT follows R_PPC64_GOT_PCREL34 if the address loaded by
+// `pld` is used only by a single load or store instruction. If `pld` is
+// relaxed to `pla`, we can fold the two instructions into a single
+// PC-relative load or store, e.g.
+//
+//   pld  r9, foo@got@pcrel  ->  plwz r3, foo+4@pcrel
+//   lwz  r3, 4(r9)          ->  nop
+//
+// Returns true if rewritten.
+static bool relax_pcrel_opt(u8 *loc, u8 *loc2, i64 val) {
+  u32 insn = *(ul32 *)loc2;
+  u32 rt = bits(*(ul32 *)(loc + 4), 25, 21);
+  if (bits(insn, 20, 16) != rt)
+    return false;
+
+  u32 prefix;
+  u32 opcode;
+  i64 disp;
+
+  switch (insn >> 26) {
+  case 32: // lwz
+  case 34: // lbz
+  case 36: // stw
+  case 38: // stb
+  case 40: // lhz
+  case 42: // lha
+  case 44: // sth
+  case 48: // lfs
+  case 50: // lfd
+  case 52: // stfs
+  case 54: // stfd
+    prefix = 0x0610'0000;
+    opcode = insn >> 26;
+    disp = sign_extend(insn & 0xffff, 15);
+    break;
+  case 58:
+    prefix = 0x0410'0000;
+    if ((insn & 3) == 0)
+      opcode = 57; // ld -> pld
+    else if ((insn & 3) == 2)
+      opcode = 41; // lwa -> plwa
+    else
+      return false;
+    disp = sign_extend(insn & 0xfffc, 15);
+    break;
+  case 62:
+    if ((insn & 3) != 0)
+      return false;
+    prefix = 0x0410'0000;
+    opcode = 61;   // std -> pstd
+    disp = sign_extend(insn & 0xfffc, 15);
+    break;
+  default:
+    return false;
+  }
+
+  val += disp;
+  if (sign_extend(val, 33) != val)
+    return false;
+
+  *(ul32 *)loc = prefix;
+  *(ul32 *)(loc + 4) = (opcode << 26) | (bits(insn, 25, 21) << 21);
+  *(ul64 *)loc |= prefix34(val);
+  *(ul32 *)loc2 = 0x6000'0000; // nop
+  return true;
+}
+
+// `addis r3, r2, .LC0@toc@ha; ld r3, .LC0@toc@l(r3)` loads an address
+// from a .toc entry. If the address is a link-time constant, we can
+// compute it directly with `addis r3, r2, foo@toc@ha; addi r3, r3,
+// foo@toc@l`, which saves one memory load. This function returns the
+// TOC-relative address of the symbol that a given .toc entry refers to
+// if that relaxation is possible.
+static std::optional<i64>
+get_toc_relaxed_val(Context<E> &ctx, Symbol<E> &sym, i64 A) {
+  if (!ctx.arg.relax)
+    return {};
+
+  InputSection<E> *isec = sym.get_input_section();
+  if (!isec || isec->name() != ".toc")
+    return {};
+
+  std::span<const ElfRel<E>> rels = isec->get_rels(ctx);
+  u64 offset = sym.value + A;
+
+  auto it = std::lower_bound(rels.begin(), rels.end(), offset,
+                             [](const ElfRel<E> &r, u64 offset) {
+    return r.r_offset < offset;
+  });
+
+  if (it == rels.end() || it->r_offset != offset ||
+      it->r_type != R_PPC64_ADDR64)
+    return {};
+
+  Symbol<E> &sym2 = *isec->file.symbols[it->r_sym];
+  if (sym2.is_imported || sym2.is_ifunc() || sym2.is_absolute() ||
+      sym2.get_type() == STT_TLS)
+    return {};
+
+  i64 val = sym2.get_addr(ctx) + it->r_addend - ctx.extra.TOC->value;
+  if (sign_extend(val, 31) != val)
+    return {};
+  return val;
+}
+
 template <>
 void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
   std::span<const ElfRel<E>> rels = get_rels(ctx);
@@ -214,13 +332,26 @@ void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
         apply_dyn_absrel(ctx, sym, rel, loc, S, A, P, dynrel);
       break;
     case R_PPC64_TOC16_HA:
-      *(ul16 *)loc = ha(S + A - TOC);
+      if (std::optional<i64> val = get_toc_relaxed_val(ctx, sym, A))
+        *(ul16 *)loc = ha(*val);
+      else
+        *(ul16 *)loc = ha(S + A - TOC);
       break;
     case R_PPC64_TOC16_LO:
       *(ul16 *)loc = lo(S + A - TOC);
       break;
-    case R_PPC64_TOC16_DS:
     case R_PPC64_TOC16_LO_DS:
+      if (std::optional<i64> val = get_toc_relaxed_val(ctx, sym, A)) {
+        // Rewrite `ld` with `addi`
+        u32 insn = *(ul32 *)loc;
+        if ((insn >> 26) != 58 || (insn & 3) != 0)
+          Fatal(ctx) << *this << ": expected `ld` for " << rel;
+        *(ul32 *)loc = (insn & 0x03ff'0000) | 0x3800'0000 | lo(*val);
+        break;
+      }
+      *(ul16 *)loc |= (S + A - TOC) & 0xfffc;
+      break;
+    case R_PPC64_TOC16_DS:
       *(ul16 *)loc |= (S + A - TOC) & 0xfffc;
       break;
     case R_PPC64_REL24:
@@ -272,9 +403,29 @@ void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
     case R_PPC64_PLT16_LO_DS:
       *(ul16 *)loc |= (G + GOT - TOC) & 0xfffc;
       break;
+    case R_PPC64_GOT_PCREL34:
+      if (can_relax_got_pcrel34(ctx, sym, loc)) {
+        i64 val = S + A - P;
+        if (sign_extend(val, 33) != val)
+          Error(ctx) << *this << ": relocation " << rel << " against "
+                     << sym << " out of range: " << val;
+
+        if (i + 1 < rels.size() && rels[i + 1].r_type == R_PPC64_PCREL_OPT &&
+            rels[i + 1].r_offset == rel.r_offset &&
+            relax_pcrel_opt(loc, loc + rels[i + 1].r_addend, val))
+          break;
+
+        // Rewrite `pld` with `pla` (i.e. `paddi rX, 0, foo@pcrel, 1`)
+        u32 rt = bits(*(ul32 *)(loc + 4), 25, 21);
+        *(ul32 *)loc = 0x0610'0000;
+        *(ul32 *)(loc + 4) = 0x3800'0000 | (rt << 21);
+        *(ul64 *)loc |= prefix34(val);
+        break;
+      }
+      *(ul64 *)loc |= prefix34(G + GOT - P);
+      break;
     case R_PPC64_PLT_PCREL34:
     case R_PPC64_PLT_PCREL34_NOTOC:
-    case R_PPC64_GOT_PCREL34:
       *(ul64 *)loc |= prefix34(G + GOT - P);
       break;
     case R_PPC64_PCREL34:
@@ -326,6 +477,7 @@ void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
     case R_PPC64_PLTSEQ_NOTOC:
     case R_PPC64_PLTCALL:
     case R_PPC64_PLTCALL_NOTOC:
+    case R_PPC64_PCREL_OPT:
     case R_PPC64_TLS:
     case R_PPC64_TLSGD:
     case R_PPC64_TLSLD:
@@ -426,9 +578,12 @@ void InputSection<E>::scan_relocations(Context<E> &ctx) {
     case R_PPC64_PLT16_HA:
     case R_PPC64_PLT_PCREL34:
     case R_PPC64_PLT_PCREL34_NOTOC:
-    case R_PPC64_GOT_PCREL34:
       sym.flags |= NEEDS_GOT;
       break;
+    case R_PPC64_GOT_PCREL34:
+      if (!can_relax_got_pcrel34(ctx, sym, (u8 *)contents.data() + rel.r_offset))
+        sym.flags |= NEEDS_GOT;
+      break;
     case R_PPC64_GOT_TLSGD16_HA:
     case R_PPC64_GOT_TLSGD_PCREL34:
       sym.flags |= NEEDS_TLSGD;
@@ -456,6 +611,7 @@ void InputSection<E>::scan_relocations(Context<E> &ctx) {
     case R_PPC64_PLTSEQ_NOTOC:
     case R_PPC64_PLTCALL:
     case R_PPC64_PLTCALL_NOTOC:
+    case R_PPC64_PCREL_OPT:
     case R_PPC64_GOT_TPREL16_LO_DS:
     case R_PPC64_GOT_TLSGD16_LO:
     case R_PPC64_GOT_TLSLD16_LO:
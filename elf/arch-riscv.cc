@@ -765,7 +765,8 @@ static i64 compute_distance(Context<E> &ctx, Symbol<E> &sym,
 template <typename E>
 static void shrink_section(Context<E> &ctx, InputSection<E> &isec, bool use_rvc) {
   std::span<const ElfRel<E>> rels = isec.get_rels(ctx);
-  isec.extra.r_deltas.resize(rels.size() + 1);
+  if (isec.extra.r_deltas.size() != rels.size() + 1)
+    isec.extra.r_deltas = ctx.arena.template make_span<i32>(rels.size() + 1);
 
   i64 delta = 0;
 
@@ -887,8 +888,8 @@ i64 riscv_resize_sections(Context<E> &ctx) {
   // Find all the relocations that can be relaxed.
   // This step should only shrink sections.
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections)
-      if (is_resizable(ctx, isec.get()))
+    for (InputSection<E> *isec : file->sections)
+      if (is_resizable(ctx, isec))
         shrink_section(ctx, *isec, use_rvc);
   });
 
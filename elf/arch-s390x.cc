@@ -108,6 +108,27 @@ void EhFrameSection<E>::apply_reloc(Context<E> &ctx, const ElfRel<E> &rel,
   }
 }
 
+// `lgrl %rX, foo@GOTENT` can be rewritten to `larl %rX, foo` if foo's
+// address is a link-time constant. In that case, we don't need to
+// create a GOT entry for foo. Since LARL can only materialize even
+// addresses, we relax it only if foo is known to be 2-byte aligned.
+static bool can_relax_gotent(Context<E> &ctx, Symbol<E> &sym,
+                             const ElfRel<E> &rel, u8 *loc) {
+  if (!ctx.arg.relax || sym.is_imported || sym.is_ifunc() || rel.r_addend != 2)
+    return false;
+
+  // Make sure that the instruction is LGRL
+  if (loc[-2] != 0xc4 || (loc[-1] & 0x0f) != 0x08)
+    return false;
+
+  InputSection<E> *isec = sym.get_input_section();
+  if (!isec)
+    return false;
+  if (isec->leader)
+    isec = isec->leader;
+  return isec->p2align >= 1 && sym.value % 2 == 0;
+}
+
 template <>
 void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
   std::span<const ElfRel<E>> rels = get_rels(ctx);
@@ -252,6 +273,13 @@ void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
       *(ub32 *)loc = (GOT + A - P) >> 1;
       break;
     case R_390_GOTENT:
+      if (can_relax_gotent(ctx, sym, rel, loc)) {
+        check_dbl(S + A - P, -(1LL << 32), 1LL << 32);
+        loc[-2] = 0xc0;
+        loc[-1] &= 0xf0;
+        *(ub32 *)loc = (S + A - P) >> 1;
+        break;
+      }
       check(GOT + G + A - P, -(1LL << 32), 1LL << 32);
       *(ub32 *)loc = (GOT + G + A - P) >> 1;
       break;
@@ -431,9 +459,12 @@ void InputSection<E>::scan_relocations(Context<E> &ctx) {
     case R_390_GOTPLT64:
     case R_390_GOTPC:
     case R_390_GOTPCDBL:
-    case R_390_GOTENT:
       sym.flags |= NEEDS_GOT;
       break;
+    case R_390_GOTENT:
+      if (!can_relax_gotent(ctx, sym, rel, (u8 *)contents.data() + rel.r_offset))
+        sym.flags |= NEEDS_GOT;
+      break;
     case R_390_PLT12DBL:
     case R_390_PLT16DBL:
     case R_390_PLT24DBL:
@@ -75,8 +75,21 @@ void write_plt_entry(Context<E> &ctx, u8 *buf, Symbol<E> &sym) {
   *(ul32 *)(buf + 12) = sym.get_gotplt_addr(ctx) - sym.get_plt_addr(ctx) - 16;
 }
 
+// If IBT is not enabled and all PLT entries are in .plt.got because of
+// `-z now`, we use compact 8-byte entries which don't start with endbr64.
 template <>
 void write_pltgot_entry(Context<E> &ctx, u8 *buf, Symbol<E> &sym) {
+  if (ctx.extra.compact_pltgot) {
+    static const u8 insn[] = {
+      0xff, 0x25, 0, 0, 0, 0, // jmp *foo@GOT
+      0x66, 0x90,             // (padding)
+    };
+
+    memcpy(buf, insn, sizeof(insn));
+    *(ul32 *)(buf + 2) = sym.get_got_addr(ctx) - sym.get_plt_addr(ctx) - 6;
+    return;
+  }
+
   static const u8 insn[] = {
     0xf3, 0x0f, 0x1e, 0xfa, // endbr64
     0xff, 0x25, 0, 0, 0, 0, // jmp *foo@GOT
@@ -113,12 +126,25 @@ void EhFrameSection<E>::apply_reloc(Context<E> &ctx, const ElfRel<E> &rel,
   }
 }
 
-static u32 relax_gotpcrelx(u8 *loc) {
+// Rewrite an indirect call or jump through GOT with a direct one in the
+// same way as GNU ld does. `loc` points to the beginning of the
+// instruction, and `val` is a displacement from the end of it.
+static bool relax_gotpcrelx(u8 *loc, i64 val) {
   switch ((loc[0] << 8) | loc[1]) {
-  case 0xff15: return 0x90e8; // call *0(%rip) -> call 0
-  case 0xff25: return 0x90e9; // jmp  *0(%rip) -> jmp  0
+  case 0xff15: // call *0(%rip) -> addr32 call 0
+    loc[0] = 0x67;
+    loc[1] = 0xe8;
+    *(ul32 *)(loc + 2) = val;
+    return true;
+  case 0xff25: // jmp *0(%rip) -> jmp 0; nop
+    if ((i32)(val + 1) != val + 1)
+      return false;
+    loc[0] = 0xe9;
+    *(ul32 *)(loc + 1) = val + 1;
+    loc[5] = 0x90;
+    return true;
   }
-  return 0;
+  return false;
 }
 
 static u32 relax_rex_gotpcrelx(u8 *loc) {
@@ -426,14 +452,9 @@ void InputSection<E>::apply_reloc_alloc(Context<E> &ctx, u8 *base) {
       // was given because some static PIE runtime code depends on these
       // relaxations.
       if (!sym.is_imported && !sym.is_ifunc() && sym.is_relative()) {
-        u32 insn = relax_gotpcrelx(loc - 2);
         i64 val = S + A - P;
-        if (insn && (i32)val == val) {
-          loc[-2] = insn >> 8;
-          loc[-1] = insn;
-          *(ul32 *)loc = val;
+        if ((i32)val == val && relax_gotpcrelx(loc - 2, val))
           break;
-        }
       }
       write32s(G + GOTPLT + A - P);
       break;
@@ -769,4 +790,24 @@ void InputSection<E>::scan_relocations(Context<E> &ctx) {
   }
 }
 
+// Returns true if the output is marked as IBT-compatible. It is marked
+// if all input object files are IBT-compatible or if `-z ibt` is given.
+bool is_ibt_enabled(Context<E> &ctx) {
+  if (ctx.arg.z_ibt)
+    return true;
+
+  bool found = false;
+  for (ObjectFile<E> *file : ctx.objs) {
+    if (file == ctx.internal_obj)
+      continue;
+
+    auto it = file->gnu_properties.find(GNU_PROPERTY_X86_FEATURE_1_AND);
+    if (it == file->gnu_properties.end() ||
+        !(it->second & GNU_PROPERTY_X86_FEATURE_1_IBT))
+      return false;
+    found = true;
+  }
+  return found;
+}
+
 } // namespace mold::elf
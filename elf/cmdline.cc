@@ -65,20 +65,29 @@ Options:
     --no-apply-dynamic-relocs
   --as-needed                 Only set DT_NEEDED if used
     --no-as-needed
-  --build-id [none,md5,sha1,sha256,uuid,HEXSTRING]
+  --binding-cache             Record DSOs that imported symbols are bound to
+    --no-binding-cache
+  --build-id [none,md5,sha1,sha256,fast,uuid,HEXSTRING]
                               Generate build ID
     --no-build-id
   --chroot DIR                Set a given path to root directory
+  --cluster-dynrels           Place sections with many dynamic relocations together
+    --no-cluster-dynrels
   --color-diagnostics=[auto,always,never]
                               Use colors in diagnostics
   --color-diagnostics         Alias for --color-diagnostics=always
   --compress-debug-sections [none,zlib,zlib-gabi,zstd]
                               Compress .debug_* sections
   --dc                        Ignored
+  --debug-names               Create .debug_names for faster debugger startup
+    --no-debug-names
   --dependency-file=FILE      Write Makefile-style dependency rules to FILE
   --defsym=SYMBOL=VALUE       Define a symbol alias
   --demangle                  Demangle C++ symbols in log messages (default)
     --no-demangle
+  --discard-dead-object-debug-info
+                              Remove debug info of object files whose code and data are all removed
+    --no-discard-dead-object-debug-info
   --enable-new-dtags          Emit DT_RUNPATH for --rpath (default)
     --disable-new-dtags       Emit DT_RPATH for --rpath
   --execute-only              Make executable segments unreadable
@@ -106,12 +115,18 @@ Options:
                               Allow merging non-executable sections with --icf
   --image-base ADDR           Set the base address to a given value
   --init SYMBOL               Call SYMBOL at load-time
+  --lazy-dso-symbols          Read only referenced symbols from shared objects
+    --no-lazy-dso-symbols
+  --lto-cache-dir DIR         Cache LTO results in DIR
+  --lto-cache-max-size SIZE   Set the maximum size of the LTO cache (default: 1 GiB)
+  --map-format=[text,json]    Set the format of the map file (default: text)
   --no-undefined              Report undefined symbols (even with --shared)
   --noinhibit-exec            Create an output file even if errors occur
   --oformat=binary            Omit ELF, section and program headers
-  --pack-dyn-relocs=[relr,none]
+  --pack-dyn-relocs=[relr,auto,none]
                               Pack dynamic relocations
   --package-metadata=STRING   Set a given string to .note.package
+  --parse-cache=DIR           Cache results of splitting mergeable sections in DIR
   --perf                      Print performance statistics
   --pie, --pic-executable     Create a position independent executable
     --no-pie, --no-pic-executable
@@ -125,6 +140,8 @@ Options:
     --no-quick-exit
   --relax                     Optimize instructions (default)
     --no-relax
+  --relocation-cache          Decode relocations only once to speed up --gc-sections and --icf
+    --no-relocation-cache
   --repro                     Embed input files to .repro section
   --require-defined SYMBOL    Require SYMBOL be defined in the final output
   --retain-symbols-file FILE  Keep only symbols listed in FILE
@@ -135,6 +152,8 @@ Options:
   --rpath-link DIR            Ignored
   --run COMMAND ARG...        Run COMMAND with mold as /usr/bin/ld
   --section-start=SECTION=ADDR Set address to section
+  --separate-debug-file[=FILE]
+                              Write debug sections to FILE (default: OUTPUT.dbg)
   --shared, --Bshareable      Create a share library
   --shuffle-sections[=SEED]   Randomize the output by shuffling input sections
   --sort-common               Ignored
@@ -143,6 +162,8 @@ Options:
   --start-lib                 Give following object files in-archive-file semantics
     --end-lib                 End the effect of --start-lib
   --stats                     Print input statistics
+  --strtab-dedup[=exact,suffix]
+                              Write each unique symbol name to .strtab only once
   --sysroot DIR               Set target system root directory
   --thread-count COUNT, --threads=COUNT
                               Use COUNT number of threads
@@ -405,6 +426,7 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
   bool warn_shared_textrel = false;
   std::optional<SeparateCodeKind> z_separate_code;
   std::optional<bool> z_relro;
+  bool separate_debug_file = false;
   std::unordered_set<std::string_view> rpaths;
 
   auto add_rpath = [&](std::string_view arg) {
@@ -581,6 +603,13 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
     } else if (read_arg("Map")) {
       ctx.arg.Map = arg;
       ctx.arg.print_map = true;
+    } else if (read_arg("map-format")) {
+      if (arg == "text")
+        ctx.arg.map_json = false;
+      else if (arg == "json")
+        ctx.arg.map_json = true;
+      else
+        Fatal(ctx) << "invalid --map-format argument: " << arg;
     } else if (read_flag("print-dependencies")) {
       ctx.arg.print_dependencies = true;
     } else if (read_flag("print-map") || read_flag("M")) {
@@ -699,6 +728,22 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
       ctx.arg.relax = true;
     } else if (read_flag("no-relax")) {
       ctx.arg.relax = false;
+    } else if (read_flag("relocation-cache")) {
+      ctx.arg.relocation_cache = true;
+    } else if (read_flag("no-relocation-cache")) {
+      ctx.arg.relocation_cache = false;
+    } else if (read_flag("debug-names")) {
+      ctx.arg.debug_names = true;
+    } else if (read_flag("no-debug-names")) {
+      ctx.arg.debug_names = false;
+    } else if (read_flag("lazy-dso-symbols")) {
+      ctx.arg.lazy_dso_symbols = true;
+    } else if (read_flag("no-lazy-dso-symbols")) {
+      ctx.arg.lazy_dso_symbols = false;
+    } else if (read_flag("discard-dead-object-debug-info")) {
+      ctx.arg.discard_dead_object_debug_info = true;
+    } else if (read_flag("no-discard-dead-object-debug-info")) {
+      ctx.arg.discard_dead_object_debug_info = false;
     } else if (read_flag("gdb-index")) {
       ctx.arg.gdb_index = true;
     } else if (read_flag("no-gdb-index")) {
@@ -712,9 +757,16 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
     } else if (read_flag("perf")) {
       ctx.arg.perf = true;
     } else if (read_flag("pack-dyn-relocs=relr")) {
+      ctx.arg.pack_dyn_relocs_auto = false;
       ctx.arg.pack_dyn_relocs_relr = true;
+    } else if (read_flag("pack-dyn-relocs=auto")) {
+      ctx.arg.pack_dyn_relocs_auto = true;
+      ctx.arg.pack_dyn_relocs_relr = false;
     } else if (read_flag("pack-dyn-relocs=none")) {
+      ctx.arg.pack_dyn_relocs_auto = false;
       ctx.arg.pack_dyn_relocs_relr = false;
+    } else if (read_arg("parse-cache")) {
+      ctx.arg.parse_cache = arg;
     } else if (read_arg("package-metadata")) {
       ctx.arg.package_metadata = arg;
     } else if (read_flag("stats")) {
@@ -722,8 +774,16 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
       Counter::enabled = true;
     } else if (read_arg("C") || read_arg("directory")) {
       ctx.arg.directory = arg;
+    } else if (read_flag("binding-cache")) {
+      ctx.arg.binding_cache = true;
+    } else if (read_flag("no-binding-cache")) {
+      ctx.arg.binding_cache = false;
     } else if (read_arg("chroot")) {
       ctx.arg.chroot = arg;
+    } else if (read_flag("cluster-dynrels")) {
+      ctx.arg.cluster_dynrels = true;
+    } else if (read_flag("no-cluster-dynrels")) {
+      ctx.arg.cluster_dynrels = false;
     } else if (read_flag("color-diagnostics") ||
                read_flag("color-diagnostics=auto")) {
       ctx.arg.color_diagnostics = isatty(STDERR_FILENO);
@@ -856,8 +916,10 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
     } else if (read_z_flag("nodefaultlib")) {
       ctx.arg.z_nodefaultlib = true;
     } else if (read_z_flag("pack-relative-relocs")) {
+      ctx.arg.pack_dyn_relocs_auto = false;
       ctx.arg.pack_dyn_relocs_relr = true;
     } else if (read_z_flag("nopack-relative-relocs")) {
+      ctx.arg.pack_dyn_relocs_auto = false;
       ctx.arg.pack_dyn_relocs_relr = false;
     } else if (read_z_flag("separate-loadable-segments")) {
       z_separate_code = SEPARATE_LOADABLE_SEGMENTS;
@@ -973,6 +1035,10 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
                                    std::string(arg));
     } else if (read_arg("thinlto-prefix-replace")) {
       ctx.arg.plugin_opt.push_back("thinlto-prefix-replace=" + std::string(arg));
+    } else if (read_arg("lto-cache-dir")) {
+      ctx.arg.lto_cache_dir = arg;
+    } else if (read_arg("lto-cache-max-size")) {
+      ctx.arg.lto_cache_max_size = parse_number(ctx, "lto-cache-max-size", arg);
     } else if (read_arg("thinlto-cache-dir")) {
       ctx.arg.plugin_opt.push_back("cache-dir=" + std::string(arg));
     } else if (read_arg("thinlto-cache-policy")) {
@@ -1010,6 +1076,24 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
       ctx.arg.undefined_version = true;
     } else if (read_flag("no-undefined-version")) {
       ctx.arg.undefined_version = false;
+    } else if (read_flag("separate-debug-file")) {
+      separate_debug_file = true;
+    } else if (read_arg("separate-debug-file")) {
+      separate_debug_file = true;
+      ctx.arg.separate_debug_file = arg;
+    } else if (read_flag("strtab-dedup")) {
+      ctx.arg.strtab_dedup = true;
+      ctx.arg.strtab_dedup_suffix = false;
+    } else if (read_arg("strtab-dedup")) {
+      if (arg == "exact") {
+        ctx.arg.strtab_dedup = true;
+        ctx.arg.strtab_dedup_suffix = false;
+      } else if (arg == "suffix") {
+        ctx.arg.strtab_dedup = true;
+        ctx.arg.strtab_dedup_suffix = true;
+      } else {
+        Fatal(ctx) << "invalid --strtab-dedup argument: " << arg;
+      }
     } else if (read_flag("build-id")) {
       ctx.arg.build_id.kind = BuildId::HASH;
       ctx.arg.build_id.hash_size = 20;
@@ -1018,6 +1102,8 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
         ctx.arg.build_id.kind = BuildId::NONE;
       } else if (arg == "uuid") {
         ctx.arg.build_id.kind = BuildId::UUID;
+      } else if (arg == "fast") {
+        ctx.arg.build_id.kind = BuildId::FAST;
       } else if (arg == "md5") {
         ctx.arg.build_id.kind = BuildId::HASH;
         ctx.arg.build_id.hash_size = 16;
@@ -1161,8 +1247,10 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
     ctx.arg.discard_all = false;
   }
 
-  if (ctx.arg.relocatable)
+  if (ctx.arg.relocatable) {
     ctx.arg.is_static = true;
+    ctx.arg.discard_dead_object_debug_info = false;
+  }
 
   // --section-order implies `-z separate-loadable-segments`
   if (z_separate_code)
@@ -1193,6 +1281,20 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx) {
   if (!ctx.arg.section_start.empty() && !ctx.arg.section_order.empty())
     Fatal(ctx) << "--section-start may not be used with --section-order";
 
+  if (ctx.arg.debug_names && ctx.arg.relocatable)
+    Fatal(ctx) << "--debug-names may not be used with --relocatable";
+
+  if (separate_debug_file) {
+    if (ctx.arg.separate_debug_file.empty())
+      ctx.arg.separate_debug_file = ctx.arg.output + ".dbg";
+    if (ctx.arg.relocatable)
+      Fatal(ctx) << "--separate-debug-file may not be used with --relocatable";
+    if (ctx.arg.oformat_binary)
+      Fatal(ctx) << "--separate-debug-file may not be used with --oformat=binary";
+    if (ctx.arg.gdb_index)
+      Fatal(ctx) << "--separate-debug-file may not be used with --gdb-index";
+  }
+
   if (ctx.arg.image_base % ctx.page_size)
     Fatal(ctx) << "-image-base must be a multiple of -max-page-size";
 
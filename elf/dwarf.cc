@@ -1,4 +1,5 @@
-// This file contains code to read DWARF debug info to create .gdb_index.
+// This file contains code to read DWARF debug info to create .gdb_index
+// and .debug_names.
 //
 // .gdb_index is an optional section to speed up GNU debugger. It contains
 // two maps: 1) a map from function/variable/type names to compunits, and
@@ -78,7 +79,7 @@ read_compunits(Context<E> &ctx, ObjectFile<E> &file) {
     if (data.size() < 4)
       Fatal(ctx) << *file.debug_info << ": corrupted .debug_info";
     if (*(U32<E> *)data.data() == 0xffff'ffff)
-      Fatal(ctx) << *file.debug_info << ": --gdb-index: DWARF64 not supported";
+      Fatal(ctx) << *file.debug_info << ": DWARF64 is not supported";
     i64 len = *(U32<E> *)data.data() + 4;
     vec.push_back(data.substr(0, len));
     data = data.substr(len);
@@ -331,7 +332,8 @@ u64 DebugInfoReader<E>::read(u64 form) {
     return val;
   }
   case DW_FORM_data8:
-  case DW_FORM_ref8: {
+  case DW_FORM_ref8:
+  case DW_FORM_ref_sig8: {
     u64 val = *(U64<E> *)cu;
     cu += 8;
     return val;
@@ -349,11 +351,14 @@ u64 DebugInfoReader<E>::read(u64 form) {
   case DW_FORM_loclistx:
   case DW_FORM_rnglistx:
     return read_uleb(cu);
+  case DW_FORM_data16:
+    cu += 16;
+    return 0;
   case DW_FORM_string:
     cu += strlen((char *)cu) + 1;
     return 0;
   default:
-    Fatal(ctx) << file << ": --gdb-index: unhandled debug info form: 0x"
+    Fatal(ctx) << file << ": unhandled debug info form: 0x"
                << std::hex << form;
     return 0;
   }
@@ -544,11 +549,356 @@ read_address_areas(Context<E> &ctx, ObjectFile<E> &file, i64 offset) {
   return {};
 }
 
+//
+// .debug_names
+//
+// .debug_names is a DWARF 5 name index. Like .gdb_index, it maps
+// names to DIEs in .debug_info, but it is a standard section and is
+// understood by both gdb and lldb.
+//
+// Clang emits a .debug_names for each compunit if -gpubnames is given.
+// Debuggers would have to look up every one of them, so we merge them
+// into a single index. GCC doesn't emit .debug_names but emits
+// .debug_gnu_pubnames and .debug_gnu_pubtypes if -ggnu-pubnames is
+// given, so we create index entries from them for such files.
+//
+// The format of .debug_names is described in section 6.1.1 of
+// https://dwarfstd.org/doc/DWARF5.pdf
+
+// The hash function for .debug_names.
+static u32 debug_names_hash(std::string_view name) {
+  u32 h = 5381;
+  for (u8 c : name) {
+    if ('A' <= c && c <= 'Z')
+      c = 'a' + c - 'A';
+    h = h * 33 + c;
+  }
+  return h;
+}
+
+// Reads a 4-byte section offset at a given offset of a non-allocated
+// input section as if the section were relocated. Returns the section
+// that the offset refers to (or nullptr if the field is not relocated)
+// and the offset.
+template <typename E>
+static std::pair<InputSection<E> *, u64>
+read_section_offset(Context<E> &ctx, InputSection<E> &isec, u64 offset) {
+  ObjectFile<E> &file = isec.file;
+  std::span<ElfRel<E>> rels = isec.get_rels(ctx);
+  typename std::span<ElfRel<E>>::iterator it;
+
+  // Relocations for RISC-V debug sections are not always sorted.
+  if constexpr (is_riscv<E>)
+    it = std::find_if(rels.begin(), rels.end(), [&](const ElfRel<E> &r) {
+      return r.r_offset == offset;
+    });
+  else
+    it = std::partition_point(rels.begin(), rels.end(),
+                              [&](const ElfRel<E> &r) {
+      return r.r_offset < offset;
+    });
+
+  if (it == rels.end() || it->r_offset != offset)
+    return {nullptr, *(U32<E> *)(isec.contents.data() + offset)};
+
+  const ElfSym<E> &esym = file.elf_syms[it->r_sym];
+  i64 shndx = file.get_shndx(esym);
+  InputSection<E> *sec =
+    (shndx < file.sections.size()) ? file.sections[shndx] : nullptr;
+  return {sec, esym.st_value + get_addend(isec, *it)};
+}
+
+// Returns the DW_TAG_* value of each abbreviation code in a
+// .debug_abbrev table at a given offset.
+template <typename E>
+static std::unordered_map<u64, u32>
+read_abbrev_tags(Context<E> &ctx, InputSection<E> &isec, u64 offset) {
+  std::unordered_map<u64, u32> map;
+  if (offset >= isec.contents.size())
+    Fatal(ctx) << isec << ": corrupted .debug_abbrev offset";
+
+  u8 *p = (u8 *)isec.contents.data() + offset;
+
+  for (;;) {
+    u64 code = read_uleb(p);
+    if (code == 0)
+      return map;
+
+    map[code] = read_uleb(p);
+    p++; // has_children byte
+
+    for (;;) {
+      u64 name = read_uleb(p);
+      u64 form = read_uleb(p);
+      if (name == 0 && form == 0)
+        break;
+      if (form == DW_FORM_implicit_const)
+        read_uleb(p);
+    }
+  }
+}
+
+// Reads names from .debug_gnu_pubnames and .debug_gnu_pubtypes. Unlike
+// .gdb_index, .debug_names needs a DIE offset and a DW_TAG_* value for
+// each name, so we read the tag of each DIE from .debug_info.
+template <typename E>
+static void
+read_debug_names_from_pubnames(Context<E> &ctx, ObjectFile<E> &file,
+                               std::vector<DebugNamesEntry<E>> &vec,
+                               std::span<const u64> cu_offsets) {
+  if (!file.debug_abbrev)
+    return;
+  file.debug_abbrev->uncompress(ctx);
+
+  std::vector<std::unordered_map<u64, u32>> abbrevs(file.compunits.size());
+  std::vector<bool> has_abbrevs(file.compunits.size());
+
+  auto get_tag = [&](i64 cu_idx, u64 die_offset) -> u32 {
+    std::string_view cu = file.compunits[cu_idx];
+    if (die_offset >= cu.size())
+      Fatal(ctx) << *file.debug_info << ": corrupted DIE offset";
+
+    if (!has_abbrevs[cu_idx]) {
+      u64 off = (*(U16<E> *)(cu.data() + 4) == 5) ? 8 : 6;
+      u64 abbrev_offset =
+        read_section_offset(ctx, *file.debug_info, cu_offsets[cu_idx] + off).second;
+      abbrevs[cu_idx] = read_abbrev_tags(ctx, *file.debug_abbrev, abbrev_offset);
+      has_abbrevs[cu_idx] = true;
+    }
+
+    u8 *p = (u8 *)cu.data() + die_offset;
+    auto it = abbrevs[cu_idx].find(read_uleb(p));
+    return (it == abbrevs[cu_idx].end()) ? 0 : it->second;
+  };
+
+  // Pubnames contain qualified names such as "ns::foo" while
+  // .debug_names is keyed by DW_AT_name such as "foo".
+  auto get_base_name = [](std::string_view name) {
+    i64 depth = 0;
+    i64 start = 0;
+    for (i64 i = 0; i < name.size(); i++) {
+      if (name[i] == '<' || name[i] == '(')
+        depth++;
+      else if (name[i] == '>' || name[i] == ')')
+        depth--;
+      else if (depth == 0 && name.substr(i).starts_with("::"))
+        start = i + 2;
+    }
+    return name.substr(start);
+  };
+
+  auto read = [&](InputSection<E> &isec) {
+    isec.uncompress(ctx);
+    std::string_view contents = isec.contents;
+    i64 pos = 0;
+
+    while (pos < contents.size()) {
+      if (contents.size() - pos < 14)
+        Fatal(ctx) << isec << ": corrupted header";
+
+      u32 len = *(U32<E> *)(contents.data() + pos) + 4;
+      u64 debug_info_offset = read_section_offset(ctx, isec, pos + 6).second;
+
+      auto it = std::lower_bound(cu_offsets.begin(), cu_offsets.end(),
+                                 debug_info_offset);
+      if (it == cu_offsets.end() || *it != debug_info_offset)
+        Fatal(ctx) << isec << ": corrupted debug_info_offset";
+      i64 cu_idx = it - cu_offsets.begin();
+
+      std::string_view data = contents.substr(pos + 14, len - 14);
+      pos += len;
+
+      while (!data.empty()) {
+        u32 offset = *(U32<E> *)data.data();
+        if (offset == 0)
+          break;
+
+        std::string_view name = data.data() + 5;
+        data = data.substr(name.size() + 6);
+
+        if (u32 tag = get_tag(cu_idx, offset)) {
+          name = get_base_name(name);
+          vec.push_back({name, debug_names_hash(name), tag, (u32)cu_idx, offset});
+        }
+      }
+    }
+  };
+
+  if (file.debug_pubnames)
+    read(*file.debug_pubnames);
+  if (file.debug_pubtypes)
+    read(*file.debug_pubtypes);
+}
+
+// Reads name index entries from input .debug_names.
+template <typename E>
+static void
+read_debug_names_from_index(Context<E> &ctx, ObjectFile<E> &file,
+                            std::vector<DebugNamesEntry<E>> &vec,
+                            std::span<const u64> cu_offsets) {
+  InputSection<E> &isec = *file.debug_names;
+  isec.uncompress(ctx);
+  u8 *begin = (u8 *)isec.contents.data();
+  i64 pos = 0;
+
+  auto read_string = [&](u64 offset) -> std::string_view {
+    auto [sec, val] = read_section_offset(ctx, isec, offset);
+    if (!sec)
+      Fatal(ctx) << isec << ": unrelocated string offset";
+    sec->uncompress(ctx);
+
+    std::string_view str = sec->contents;
+    if (val >= str.size() || str.find('\0', val) == str.npos)
+      Fatal(ctx) << isec << ": corrupted string offset";
+    return str.data() + val;
+  };
+
+  while (pos < isec.contents.size()) {
+    if (isec.contents.size() - pos < 36)
+      Fatal(ctx) << isec << ": corrupted header";
+
+    u8 *hdr = begin + pos;
+    if (*(U32<E> *)hdr == 0xffff'ffff)
+      Fatal(ctx) << isec << ": DWARF64 is not supported";
+    if (u32 version = *(U16<E> *)(hdr + 4); version != 5)
+      Fatal(ctx) << isec << ": unknown .debug_names version: " << version;
+
+    i64 end = pos + 4 + *(U32<E> *)hdr;
+    u32 cu_count = *(U32<E> *)(hdr + 8);
+    u32 local_tu_count = *(U32<E> *)(hdr + 12);
+    u32 foreign_tu_count = *(U32<E> *)(hdr + 16);
+    u32 bucket_count = *(U32<E> *)(hdr + 20);
+    u32 name_count = *(U32<E> *)(hdr + 24);
+    u32 abbrev_table_size = *(U32<E> *)(hdr + 28);
+    u32 augmentation_size = *(U32<E> *)(hdr + 32);
+
+    i64 cu_list = pos + 36 + align_to(augmentation_size, 4);
+    i64 buckets = cu_list + cu_count * 4 + local_tu_count * 4 +
+                  foreign_tu_count * 8;
+    i64 str_offsets = buckets + bucket_count * 4 +
+                      (bucket_count ? name_count * 4 : 0);
+    i64 entry_offsets = str_offsets + name_count * 4;
+    i64 abbrev_table = entry_offsets + name_count * 4;
+    i64 entry_pool = abbrev_table + abbrev_table_size;
+
+    if (isec.contents.size() < end || end < entry_pool)
+      Fatal(ctx) << isec << ": corrupted .debug_names";
+
+    // Map compunit indices in this index to ones in this file.
+    std::vector<u32> cus;
+    for (i64 i = 0; i < cu_count; i++) {
+      u64 offset = read_section_offset(ctx, isec, cu_list + i * 4).second;
+      auto it = std::lower_bound(cu_offsets.begin(), cu_offsets.end(), offset);
+      if (it == cu_offsets.end() || *it != offset)
+        Fatal(ctx) << isec << ": corrupted compunit offset";
+      cus.push_back(it - cu_offsets.begin());
+    }
+
+    // Read the abbreviation table.
+    struct Abbrev {
+      u32 tag;
+      std::vector<std::pair<u64, u64>> attrs;
+    };
+
+    std::unordered_map<u64, Abbrev> abbrevs;
+    u8 *p = begin + abbrev_table;
+
+    while (u64 code = read_uleb(p)) {
+      Abbrev &abbrev = abbrevs[code];
+      abbrev.tag = read_uleb(p);
+      for (;;) {
+        u64 idx = read_uleb(p);
+        u64 form = read_uleb(p);
+        if (idx == 0 && form == 0)
+          break;
+        abbrev.attrs.push_back({idx, form});
+      }
+    }
+
+    // Read entries. We drop DW_IDX_parent because parent entries may
+    // be merged with entries from other files.
+    for (i64 i = 0; i < name_count; i++) {
+      std::string_view name = read_string(str_offsets + i * 4);
+      u32 hash = debug_names_hash(name);
+      DebugInfoReader<E> reader{ctx, file,
+        begin + entry_pool + *(U32<E> *)(begin + entry_offsets + i * 4)};
+
+      while (u64 code = read_uleb(reader.cu)) {
+        auto it = abbrevs.find(code);
+        if (it == abbrevs.end())
+          Fatal(ctx) << isec << ": unknown abbreviation code: " << code;
+
+        i64 cu_idx = (cu_count == 1) ? cus[0] : -1;
+        i64 die_offset = -1;
+        bool is_type_unit = false;
+
+        for (auto [idx, form] : it->second.attrs) {
+          u64 val = reader.read(form);
+          if (idx == DW_IDX_compile_unit)
+            cu_idx = (val < cu_count) ? cus[val] : -1;
+          else if (idx == DW_IDX_type_unit)
+            is_type_unit = true;
+          else if (idx == DW_IDX_die_offset)
+            die_offset = val;
+        }
+
+        if (!is_type_unit && cu_idx != -1 && die_offset != -1)
+          vec.push_back({name, hash, it->second.tag, (u32)cu_idx,
+                         (u32)die_offset});
+      }
+    }
+
+    pos = end;
+  }
+}
+
+// Reads names for --debug-names. Compunit indices of the returned
+// entries are local to the file.
+template <typename E>
+std::vector<DebugNamesEntry<E>>
+read_debug_names(Context<E> &ctx, ObjectFile<E> &file) {
+  std::vector<DebugNamesEntry<E>> vec;
+  if (!file.debug_info)
+    return vec;
+
+  file.compunits = read_compunits(ctx, file);
+
+  std::vector<u64> cu_offsets;
+  u64 offset = 0;
+  for (std::string_view cu : file.compunits) {
+    cu_offsets.push_back(offset);
+    offset += cu.size();
+  }
+
+  if (file.debug_names)
+    read_debug_names_from_index(ctx, file, vec, cu_offsets);
+  else
+    read_debug_names_from_pubnames(ctx, file, vec, cu_offsets);
+
+  // Uniquify elements because GCC emits duplicate pubnames records
+  // for comdat groups.
+  auto key = [](const DebugNamesEntry<E> &x) {
+    return std::tuple(x.name, x.cu_idx, x.die_offset, x.tag);
+  };
+
+  sort(vec, [&](const DebugNamesEntry<E> &a, const DebugNamesEntry<E> &b) {
+    return key(a) < key(b);
+  });
+
+  vec.erase(std::unique(vec.begin(), vec.end(),
+                        [&](const DebugNamesEntry<E> &a,
+                            const DebugNamesEntry<E> &b) {
+    return key(a) == key(b);
+  }), vec.end());
+  return vec;
+}
+
 using E = MOLD_TARGET;
 
 template std::vector<std::string_view> read_compunits(Context<E> &, ObjectFile<E> &);
 template std::vector<GdbIndexName> read_pubnames(Context<E> &, ObjectFile<E> &);
 template i64 estimate_address_areas(Context<E> &, ObjectFile<E> &);
 template std::vector<u64> read_address_areas(Context<E> &, ObjectFile<E> &, i64);
+template std::vector<DebugNamesEntry<E>> read_debug_names(Context<E> &, ObjectFile<E> &);
 
 } // namespace mold::elf
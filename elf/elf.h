@@ -315,6 +315,7 @@ enum : u32 {
   NT_GNU_GOLD_VERSION = 4,
   NT_GNU_PROPERTY_TYPE_0 = 5,
   NT_FDO_PACKAGING_METADATA = 0xcafe1a7e,
+  NT_MOLD_BINDING_CACHE = 1,
 };
 
 enum : u32 {
@@ -1324,6 +1325,13 @@ enum : u32 {
   DW_RLE_start_length = 0x07,
 };
 
+enum : u32 {
+  DW_IDX_compile_unit = 0x01,
+  DW_IDX_type_unit = 0x02,
+  DW_IDX_die_offset = 0x03,
+  DW_IDX_parent = 0x04,
+};
+
 //
 // ELF types
 //
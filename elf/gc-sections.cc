@@ -1,14 +1,71 @@
 // This file implements a mark-sweep garbage collector for -gc-sections.
 // In this algorithm, vertices are sections and edges are relocations.
 // Any section that is reachable from a root section is considered alive.
+//
+// Input sections are scattered across the heap, and following a
+// relocation to its target section requires chasing several pointers
+// (relocation -> symbol -> input section). To make the mark phase
+// cache-friendly, we first give each input section a dense index and
+// convert the relocation graph into a compact edge list in the CSR
+// (compressed sparse row) format. Mark bits are kept in a contiguous
+// atomic bitmap indexed by the dense section index.
 
 #include "mold.h"
 
-#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 
 namespace mold::elf {
 
+// An edge refers either to another input section or to a section
+// fragment. We use the least significant bit to distinguish them.
+// Fragments are at least 4-byte aligned, so the bit is always available.
+static constexpr uintptr_t EDGE_FRAG = 1;
+
+// A bitmap whose bits can be set by multiple threads concurrently.
+class AtomicBitVector {
+public:
+  AtomicBitVector(i64 size) : vec((size + 63) / 64) {}
+
+  bool get(i64 idx) const {
+    return vec[idx / 64].load(std::memory_order_relaxed) & mask(idx);
+  }
+
+  void set(i64 idx) {
+    vec[idx / 64].fetch_or(mask(idx), std::memory_order_relaxed);
+  }
+
+  // Sets a bit and returns its previous value. As with
+  // Atomic<bool>::test_and_set, we do an optimistic early load
+  // to avoid an expensive RMW if the bit is already set.
+  bool test_and_set(i64 idx) {
+    return get(idx) ||
+           (vec[idx / 64].fetch_or(mask(idx), std::memory_order_relaxed) &
+            mask(idx));
+  }
+
+private:
+  static u64 mask(i64 idx) { return (u64)1 << (idx % 64); }
+
+  std::vector<std::atomic_uint64_t> vec;
+};
+
+struct GcGraph {
+  GcGraph(i64 num_sections)
+    : visited(num_sections), edge_begin(num_sections + 1),
+      num_edges(num_sections) {}
+
+  AtomicBitVector visited;
+
+  // `edges[edge_begin[i]]` to `edges[edge_begin[i] + num_edges[i]]` are
+  // outgoing edges of the i'th section. `edge_begin` is computed from an
+  // upper bound of the number of edges, so there may be unused slots
+  // between sections.
+  std::vector<u64> edge_begin;
+  std::vector<u32> num_edges;
+  std::vector<uintptr_t> edges;
+};
+
 template <typename E>
 static bool should_keep(const InputSection<E> &isec) {
   u32 type = isec.shdr().sh_type;
@@ -29,53 +86,112 @@ static bool should_keep(const InputSection<E> &isec) {
 }
 
 template <typename E>
-static bool mark_section(InputSection<E> *isec) {
-  return isec && isec->is_alive && !isec->is_visited.test_and_set();
+static i64 get_section_idx(InputSection<E> &isec) {
+  return isec.file.gc_section_idx + isec.shndx;
 }
 
+// Assign dense indices to input sections.
 template <typename E>
-static void visit(Context<E> &ctx, InputSection<E> *isec,
-                  tbb::feeder<InputSection<E> *> &feeder, i64 depth) {
-  assert(isec->is_visited);
-
-  // If this is a text section, .eh_frame may contain records
-  // describing how to handle exceptions for that function.
-  // We want to keep associated .eh_frame records.
-  for (FdeRecord<E> &fde : isec->get_fdes())
-    for (const ElfRel<E> &rel : fde.get_rels(isec->file).subspan(1))
-      if (Symbol<E> *sym = isec->file.symbols[rel.r_sym])
-        if (mark_section(sym->get_input_section()))
-          feeder.add(sym->get_input_section());
-
-  for (const ElfRel<E> &rel : isec->get_rels(ctx)) {
-    Symbol<E> &sym = *isec->file.symbols[rel.r_sym];
-
-    // Symbol can refer either a section fragment or an input section.
-    // Mark a fragment as alive.
-    if (SectionFragment<E> *frag = sym.get_frag()) {
-      frag->is_alive = true;
-      continue;
+static i64 assign_section_indices(Context<E> &ctx) {
+  i64 idx = 0;
+  for (ObjectFile<E> *file : ctx.objs) {
+    file->gc_section_idx = idx;
+    idx += file->sections.size();
+  }
+  return idx;
+}
+
+// Compute an upper bound of the number of outgoing edges for each
+// section and mark sections that are not subject to garbage collection
+// as visited so that the mark phase doesn't have to care about them.
+template <typename E>
+static void count_edges(Context<E> &ctx, GcGraph &g) {
+  Timer t(ctx, "count_edges");
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    for (i64 i = 0; i < file->sections.size(); i++) {
+      InputSection<E> *isec = file->sections[i];
+      i64 idx = file->gc_section_idx + i;
+
+      // --gc-sections discards only SHF_ALLOC sections. If you want to
+      // reduce the amount of non-memory-mapped segments, you should
+      // use `strip` command, compile without debug info or use
+      // --strip-all linker option.
+      if (!isec || !isec->is_alive || !(isec->shdr().sh_flags & SHF_ALLOC)) {
+        g.visited.set(idx);
+        continue;
+      }
+
+      i64 n = isec->get_rels(ctx).size();
+      for (FdeRecord<E> &fde : isec->get_fdes())
+        n += fde.get_rels(*file).size();
+      g.edge_begin[idx + 1] = n;
     }
+  });
 
-    // Mark a section alive. For better performacne, we don't call
-    // `feeder.add` too often.
-    if (mark_section(sym.get_input_section())) {
-      if (depth < 3)
-        visit(ctx, sym.get_input_section(), feeder, depth + 1);
-      else
-        feeder.add(sym.get_input_section());
+  for (i64 i = 1; i < g.edge_begin.size(); i++)
+    g.edge_begin[i] += g.edge_begin[i - 1];
+  g.edges.resize(g.edge_begin.back());
+}
+
+// Convert relocations to edges.
+template <typename E>
+static void fill_edges(Context<E> &ctx, GcGraph &g) {
+  Timer t(ctx, "fill_edges");
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    for (i64 i = 0; i < file->sections.size(); i++) {
+      i64 idx = file->gc_section_idx + i;
+      if (g.visited.get(idx))
+        continue;
+
+      InputSection<E> &isec = *file->sections[i];
+      uintptr_t *edges = g.edges.data() + g.edge_begin[idx];
+      i64 n = 0;
+
+      // If this is a text section, .eh_frame may contain records
+      // describing how to handle exceptions for that function.
+      // We want to keep associated .eh_frame records.
+      for (FdeRecord<E> &fde : isec.get_fdes())
+        for (const ElfRel<E> &rel : fde.get_rels(*file).subspan(1))
+          if (Symbol<E> *sym = file->symbols[rel.r_sym])
+            if (InputSection<E> *target = sym->get_input_section())
+              edges[n++] = get_section_idx(*target) << 1;
+
+      // Symbol can refer either a section fragment or an input section.
+      auto add_edge = [&](Symbol<E> &sym) {
+        if (SectionFragment<E> *frag = sym.get_frag())
+          edges[n++] = (uintptr_t)frag | EDGE_FRAG;
+        else if (InputSection<E> *target = sym.get_input_section())
+          edges[n++] = get_section_idx(*target) << 1;
+      };
+
+      if (ctx.arg.relocation_cache) {
+        for (DecodedRel<E> &r : isec.decoded_rels)
+          add_edge(*r.sym);
+      } else {
+        for (const ElfRel<E> &rel : isec.get_rels(ctx))
+          add_edge(*file->symbols[rel.r_sym]);
+      }
+
+      g.num_edges[idx] = n;
     }
-  }
+  });
 }
 
 template <typename E>
-static void collect_root_set(Context<E> &ctx,
-                             tbb::concurrent_vector<InputSection<E> *> &rootset) {
+static std::vector<u32>
+collect_root_set(Context<E> &ctx, GcGraph &g) {
   Timer t(ctx, "collect_root_set");
 
+  tbb::enumerable_thread_specific<std::vector<u32>> rootsets;
+
   auto enqueue_section = [&](InputSection<E> *isec) {
-    if (mark_section(isec))
-      rootset.push_back(isec);
+    if (isec) {
+      i64 idx = get_section_idx(*isec);
+      if (!g.visited.test_and_set(idx))
+        rootsets.local().push_back(idx);
+    }
   };
 
   auto enqueue_symbol = [&](Symbol<E> *sym) {
@@ -87,30 +203,23 @@ static void collect_root_set(Context<E> &ctx,
     }
   };
 
-  // Add sections that are not subject to garbage collection.
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
-      if (!isec || !isec->is_alive)
-        continue;
+    // Add sections that are not subject to garbage collection.
+    for (InputSection<E> *isec : file->sections)
+      if (isec && isec->is_alive && should_keep(*isec))
+        enqueue_section(isec);
 
-      // --gc-sections discards only SHF_ALLOC sections. If you want to
-      // reduce the amount of non-memory-mapped segments, you should
-      // use `strip` command, compile without debug info or use
-      // --strip-all linker option.
-      u32 flags = isec->shdr().sh_flags;
-      if (!(flags & SHF_ALLOC))
-        isec->is_visited = true;
-
-      if (should_keep(*isec))
-        enqueue_section(isec.get());
-    }
-  });
-
-  // Add sections containing exported symbols
-  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    // Add sections containing exported symbols
     for (Symbol<E> *sym : file->symbols)
       if (sym->file == file && sym->is_exported)
         enqueue_symbol(sym);
+
+    // .eh_frame consists of variable-length records called CIE and FDE
+    // records, and they are a unit of inclusion or exclusion.
+    // We just keep all CIEs and everything that are referenced by them.
+    for (CieRecord<E> &cie : file->cies)
+      for (const ElfRel<E> &rel : cie.get_rels())
+        enqueue_symbol(file->symbols[rel.r_sym]);
   });
 
   // Add sections referenced by root symbols.
@@ -122,40 +231,61 @@ static void collect_root_set(Context<E> &ctx,
   for (std::string_view name : ctx.arg.require_defined)
     enqueue_symbol(get_symbol(ctx, name));
 
-  // .eh_frame consists of variable-length records called CIE and FDE
-  // records, and they are a unit of inclusion or exclusion.
-  // We just keep all CIEs and everything that are referenced by them.
-  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (CieRecord<E> &cie : file->cies)
-      for (const ElfRel<E> &rel : cie.get_rels())
-        enqueue_symbol(file->symbols[rel.r_sym]);
-  });
+  std::vector<u32> rootset;
+  for (std::vector<u32> &vec : rootsets)
+    append(rootset, vec);
+  return rootset;
+}
+
+template <typename E>
+static void visit(GcGraph &g, u32 idx, tbb::feeder<u32> &feeder, i64 depth) {
+  assert(g.visited.get(idx));
+
+  uintptr_t *begin = g.edges.data() + g.edge_begin[idx];
+  uintptr_t *end = begin + g.num_edges[idx];
+
+  for (uintptr_t *p = begin; p != end; p++) {
+    // Mark a fragment as alive.
+    if (*p & EDGE_FRAG) {
+      ((SectionFragment<E> *)(*p & ~EDGE_FRAG))->is_alive = true;
+      continue;
+    }
+
+    // Mark a section alive. For better performacne, we don't call
+    // `feeder.add` too often.
+    u32 target = *p >> 1;
+    if (!g.visited.test_and_set(target)) {
+      if (depth < 3)
+        visit<E>(g, target, feeder, depth + 1);
+      else
+        feeder.add(target);
+    }
+  }
 }
 
 // Mark all reachable sections
 template <typename E>
-static void mark(Context<E> &ctx,
-                 tbb::concurrent_vector<InputSection<E> *> &rootset) {
+static void mark(Context<E> &ctx, GcGraph &g, std::vector<u32> &rootset) {
   Timer t(ctx, "mark");
 
-  tbb::parallel_for_each(rootset, [&](InputSection<E> *isec,
-                                    tbb::feeder<InputSection<E> *> &feeder) {
-    visit(ctx, isec, feeder, 0);
+  tbb::parallel_for_each(rootset, [&](u32 idx, tbb::feeder<u32> &feeder) {
+    visit<E>(g, idx, feeder, 0);
   });
 }
 
 // Remove unreachable sections
 template <typename E>
-static void sweep(Context<E> &ctx) {
+static void sweep(Context<E> &ctx, GcGraph &g) {
   Timer t(ctx, "sweep");
   static Counter counter("garbage_sections");
 
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
-      if (isec && isec->is_alive && !isec->is_visited) {
+    for (i64 i = 0; i < file->sections.size(); i++) {
+      if (!g.visited.get(file->gc_section_idx + i)) {
+        InputSection<E> &isec = *file->sections[i];
         if (ctx.arg.print_gc_sections)
-          SyncOut(ctx) << "removing unused section " << *isec;
-        isec->kill();
+          SyncOut(ctx) << "removing unused section " << isec;
+        isec.kill();
         counter++;
       }
     }
@@ -166,10 +296,13 @@ template <typename E>
 void gc_sections(Context<E> &ctx) {
   Timer t(ctx, "gc");
 
-  tbb::concurrent_vector<InputSection<E> *> rootset;
-  collect_root_set(ctx, rootset);
-  mark(ctx, rootset);
-  sweep(ctx);
+  GcGraph g(assign_section_indices(ctx));
+  count_edges(ctx, g);
+  fill_edges(ctx, g);
+
+  std::vector<u32> rootset = collect_root_set(ctx, g);
+  mark(ctx, g, rootset);
+  sweep(ctx, g);
 }
 
 using E = MOLD_TARGET;
@@ -50,7 +50,7 @@
 // put the function they call into the hash by appending the hash of those
 // functions from the previous iteration. This means that the nth iteration
 // hashes call chain up to (n-1) levels deep.
-// We use a cryptographic hash function, so the unique number of hashes will
+// We use a 128-bit hash function, so the unique number of hashes will
 // only monotonically increase as we take into account of deeper trees with
 // iterations (otherwise, that means we have found a hash collision). We stop
 // when the unique number of hashes stop increasing; this is based on the fact
@@ -58,6 +58,12 @@
 // the previous iteration, it will remain unchanged for further iterations.
 // This is provable, but here we omit the proof for brevity.
 //
+// The hash function is XXH3-128, which is not cryptographic but much
+// faster than SHA256. Since we don't rely on the hash being collision-
+// resistant, we compare each section with its leader byte-by-byte and
+// relocation-by-relocation after grouping, and sections that turn out to
+// be different from their leaders are excluded from folding.
+//
 // When compared to other approaches, mold's approach has a relatively cheaper
 // cost per iteration, and as a bonus, is highly parallelizable.
 // For Chromium, mold's ICF finishes in less than 1 second with 20 threads,
@@ -65,7 +71,6 @@
 // conditions.
 
 #include "mold.h"
-#include "../common/sha.h"
 
 #include <array>
 #include <cstdio>
@@ -90,26 +95,6 @@ template<> struct hash<Digest> {
 
 namespace mold::elf {
 
-template <typename E>
-static void uniquify_cies(Context<E> &ctx) {
-  Timer t(ctx, "uniquify_cies");
-  std::vector<CieRecord<E> *> cies;
-
-  for (ObjectFile<E> *file : ctx.objs) {
-    for (CieRecord<E> &cie : file->cies) {
-      for (i64 i = 0; i < cies.size(); i++) {
-        if (cie.equals(*cies[i])) {
-          cie.icf_idx = i;
-          goto found;
-        }
-      }
-      cie.icf_idx = cies.size();
-      cies.push_back(&cie);
-    found:;
-    }
-  }
-}
-
 template <typename E>
 static bool is_eligible(Context<E> &ctx, InputSection<E> &isec) {
   const ElfShdr<E> &shdr = isec.shdr();
@@ -132,14 +117,26 @@ static bool is_eligible(Context<E> &ctx, InputSection<E> &isec) {
          !is_init && !is_fini && !is_enumerable && !is_addr_taken;
 }
 
-static Digest digest_final(SHA256Hash &sha) {
-  u8 buf[SHA256_SIZE];
-  sha.finish(buf);
+class Digester {
+public:
+  Digester() { XXH3_128bits_reset(&state); }
 
-  Digest digest;
-  memcpy(digest.data(), buf, HASH_SIZE);
-  return digest;
-}
+  void update(const void *data, i64 size) {
+    XXH3_128bits_update(&state, data, size);
+  }
+
+  Digest finish() {
+    XXH128_canonical_t canon;
+    XXH128_canonicalFromHash(&canon, XXH3_128bits_digest(&state));
+
+    Digest digest;
+    memcpy(digest.data(), canon.digest, HASH_SIZE);
+    return digest;
+  }
+
+private:
+  XXH3_state_t state;
+};
 
 template <typename E>
 static bool is_leaf(Context<E> &ctx, InputSection<E> &isec) {
@@ -199,7 +196,7 @@ static void merge_leaf_nodes(Context<E> &ctx) {
                                 LeafHasher<E>, LeafEq<E>> map;
 
   tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
-    for (std::unique_ptr<InputSection<E>> &isec : ctx.objs[i]->sections) {
+    for (InputSection<E> *isec : ctx.objs[i]->sections) {
       if (!isec || !isec->is_alive)
         continue;
 
@@ -211,9 +208,9 @@ static void merge_leaf_nodes(Context<E> &ctx) {
       if (is_leaf(ctx, *isec)) {
         leaf++;
         isec->icf_leaf = true;
-        auto [it, inserted] = map.insert({isec.get(), isec.get()});
+        auto [it, inserted] = map.insert({isec, isec});
         if (!inserted && isec->get_priority() < it->second->get_priority())
-          it->second = isec.get();
+          it->second = isec;
       } else {
         eligible++;
         isec->icf_eligible = true;
@@ -222,9 +219,9 @@ static void merge_leaf_nodes(Context<E> &ctx) {
   });
 
   tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
-    for (std::unique_ptr<InputSection<E>> &isec : ctx.objs[i]->sections) {
+    for (InputSection<E> *isec : ctx.objs[i]->sections) {
       if (isec && isec->is_alive && isec->icf_leaf) {
-        auto it = map.find(isec.get());
+        auto it = map.find(isec);
         assert(it != map.end());
         isec->leader = it->second;
       }
@@ -234,15 +231,15 @@ static void merge_leaf_nodes(Context<E> &ctx) {
 
 template <typename E>
 static Digest compute_digest(Context<E> &ctx, InputSection<E> &isec) {
-  SHA256Hash sha;
+  Digester digester;
 
   auto hash = [&](auto val) {
-    sha.update((u8 *)&val, sizeof(val));
+    digester.update(&val, sizeof(val));
   };
 
   auto hash_string = [&](std::string_view str) {
     hash(str.size());
-    sha.update((u8 *)str.data(), str.size());
+    digester.update(str.data(), str.size());
   };
 
   auto hash_symbol = [&](Symbol<E> &sym) {
@@ -274,7 +271,7 @@ static Digest compute_digest(Context<E> &ctx, InputSection<E> &isec) {
   hash(isec.get_rels(ctx).size());
 
   for (FdeRecord<E> &fde : isec.get_fdes()) {
-    hash(isec.file.cies[fde.cie_idx].icf_idx);
+    hash(isec.file.cies[fde.cie_idx].leader_idx);
 
     // Bytes 0 to 4 contain the length of this record, and
     // bytes 4 to 8 contain an offset to CIE.
@@ -290,15 +287,23 @@ static Digest compute_digest(Context<E> &ctx, InputSection<E> &isec) {
     }
   }
 
-  for (i64 i = 0; i < isec.get_rels(ctx).size(); i++) {
-    const ElfRel<E> &rel = isec.get_rels(ctx)[i];
-    hash(rel.r_offset);
-    hash(rel.r_type);
-    hash(get_addend(isec, rel));
-    hash_symbol(*isec.file.symbols[rel.r_sym]);
+  if (ctx.arg.relocation_cache) {
+    for (DecodedRel<E> &r : isec.decoded_rels) {
+      hash((u64)r.r_offset);
+      hash(r.r_type);
+      hash(r.addend);
+      hash_symbol(*r.sym);
+    }
+  } else {
+    for (const ElfRel<E> &rel : isec.get_rels(ctx)) {
+      hash((u64)rel.r_offset);
+      hash((u32)rel.r_type);
+      hash(get_addend(isec, rel));
+      hash_symbol(*isec.file.symbols[rel.r_sym]);
+    }
   }
 
-  return digest_final(sha);
+  return digester.finish();
 }
 
 template <typename E>
@@ -309,7 +314,7 @@ static std::vector<InputSection<E> *> gather_sections(Context<E> &ctx) {
   std::vector<i64> num_sections(ctx.objs.size());
 
   tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
-    for (std::unique_ptr<InputSection<E>> &isec : ctx.objs[i]->sections)
+    for (InputSection<E> *isec : ctx.objs[i]->sections)
       if (isec && isec->is_alive && isec->icf_eligible)
         num_sections[i]++;
   });
@@ -324,9 +329,9 @@ static std::vector<InputSection<E> *> gather_sections(Context<E> &ctx) {
   // Fill `sections` contents.
   tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
     i64 idx = section_indices[i];
-    for (std::unique_ptr<InputSection<E>> &isec : ctx.objs[i]->sections)
+    for (InputSection<E> *isec : ctx.objs[i]->sections)
       if (isec && isec->is_alive && isec->icf_eligible)
-        sections[idx++] = isec.get();
+        sections[idx++] = isec;
   });
 
   tbb::parallel_for((i64)0, (i64)sections.size(), [&](i64 i) {
@@ -348,6 +353,18 @@ compute_digests(Context<E> &ctx, std::span<InputSection<E> *> sections) {
   return digests;
 }
 
+// Calls `fn` for each symbol referred to by relocations of a given section.
+template <typename E, typename Fn>
+static void for_each_rel_sym(Context<E> &ctx, InputSection<E> &isec, Fn fn) {
+  if (ctx.arg.relocation_cache) {
+    for (DecodedRel<E> &r : isec.decoded_rels)
+      fn(*r.sym);
+  } else {
+    for (const ElfRel<E> &rel : isec.get_rels(ctx))
+      fn(*isec.file.symbols[rel.r_sym]);
+  }
+}
+
 // Build a graph, treating every function as a vertex and every function call
 // as an edge. See the description at the top for a more detailed formulation.
 // We use u32 indices here to improve cache locality.
@@ -368,14 +385,12 @@ static void gather_edges(Context<E> &ctx,
     InputSection<E> &isec = *sections[i];
     assert(isec.icf_eligible);
 
-    for (i64 j = 0; j < isec.get_rels(ctx).size(); j++) {
-      const ElfRel<E> &rel = isec.get_rels(ctx)[j];
-      Symbol<E> &sym = *isec.file.symbols[rel.r_sym];
+    for_each_rel_sym(ctx, isec, [&](Symbol<E> &sym) {
       if (!sym.get_frag())
         if (InputSection<E> *isec = sym.get_input_section())
           if (isec->icf_eligible)
             num_edges[i]++;
-    }
+    });
   });
 
   for (i64 i = 0; i < num_edges.size() - 1; i++)
@@ -387,12 +402,11 @@ static void gather_edges(Context<E> &ctx,
     InputSection<E> &isec = *sections[i];
     i64 idx = edge_indices[i];
 
-    for (ElfRel<E> &rel : isec.get_rels(ctx)) {
-      Symbol<E> &sym = *isec.file.symbols[rel.r_sym];
+    for_each_rel_sym(ctx, isec, [&](Symbol<E> &sym) {
       if (InputSection<E> *isec = sym.get_input_section())
         if (isec->icf_eligible)
           edges[idx++] = isec->icf_idx;
-  }
+    });
   });
 }
 
@@ -411,16 +425,16 @@ static i64 propagate(std::span<std::vector<Digest>> digests,
     if (converged.get(i))
       return;
 
-    SHA256Hash sha;
-    sha.update(digests[2][i].data(), HASH_SIZE);
+    Digester digester;
+    digester.update(digests[2][i].data(), HASH_SIZE);
 
     i64 begin = edge_indices[i];
     i64 end = (i + 1 == num_digests) ? edges.size() : edge_indices[i + 1];
 
     for (i64 j : edges.subspan(begin, end - begin))
-      sha.update(digests[slot][j].data(), HASH_SIZE);
+      digester.update(digests[slot][j].data(), HASH_SIZE);
 
-    digests[!slot][i] = digest_final(sha);
+    digests[!slot][i] = digester.finish();
 
     if (digests[slot][i] == digests[!slot][i]) {
       // This node has converged. Skip further iterations as it will
@@ -449,18 +463,130 @@ static i64 count_num_classes(std::span<Digest> digests,
   return num_classes.combine(std::plus());
 }
 
+// Returns true if two symbols would be hashed to the same value by
+// compute_digest(), assuming that their sections' leaders are final.
+template <typename E>
+static bool is_same_symbol(Symbol<E> &a, Symbol<E> &b) {
+  if (a.value != b.value)
+    return false;
+
+  if (!a.file || !b.file)
+    return &a == &b;
+
+  SectionFragment<E> *frag1 = a.get_frag();
+  SectionFragment<E> *frag2 = b.get_frag();
+  if (frag1 || frag2)
+    return frag1 == frag2;
+
+  InputSection<E> *isec1 = a.get_input_section();
+  InputSection<E> *isec2 = b.get_input_section();
+  if (!isec1 || !isec2)
+    return !isec1 && !isec2;
+  if (isec1->leader || isec2->leader)
+    return isec1->leader == isec2->leader;
+  return isec1 == isec2;
+}
+
+template <typename E>
+static bool is_same_section(Context<E> &ctx, InputSection<E> &a,
+                            InputSection<E> &b) {
+  if (a.contents != b.contents ||
+      a.shdr().sh_flags != b.shdr().sh_flags ||
+      a.get_rels(ctx).size() != b.get_rels(ctx).size())
+    return false;
+
+  std::span<FdeRecord<E>> fdes1 = a.get_fdes();
+  std::span<FdeRecord<E>> fdes2 = b.get_fdes();
+  if (fdes1.size() != fdes2.size())
+    return false;
+
+  for (i64 i = 0; i < fdes1.size(); i++) {
+    FdeRecord<E> &x = fdes1[i];
+    FdeRecord<E> &y = fdes2[i];
+    CieRecord<E> &cie1 = a.file.cies[x.cie_idx];
+    CieRecord<E> &cie2 = b.file.cies[y.cie_idx];
+
+    if (cie1.leader_idx != cie2.leader_idx ||
+        x.get_contents(a.file).substr(8) != y.get_contents(b.file).substr(8))
+      return false;
+
+    std::span<const ElfRel<E>> rels1 = x.get_rels(a.file);
+    std::span<const ElfRel<E>> rels2 = y.get_rels(b.file);
+    if (rels1.size() != rels2.size())
+      return false;
+
+    for (i64 j = 1; j < rels1.size(); j++)
+      if (rels1[j].r_type != rels2[j].r_type ||
+          rels1[j].r_offset - x.input_offset != rels2[j].r_offset - y.input_offset ||
+          get_addend(cie1.input_section, rels1[j]) !=
+          get_addend(cie2.input_section, rels2[j]) ||
+          !is_same_symbol(*a.file.symbols[rels1[j].r_sym],
+                          *b.file.symbols[rels2[j].r_sym]))
+        return false;
+  }
+
+  if (ctx.arg.relocation_cache) {
+    for (i64 i = 0; i < a.decoded_rels.size(); i++) {
+      DecodedRel<E> &x = a.decoded_rels[i];
+      DecodedRel<E> &y = b.decoded_rels[i];
+      if (x.r_offset != y.r_offset || x.r_type != y.r_type ||
+          x.addend != y.addend || !is_same_symbol(*x.sym, *y.sym))
+        return false;
+    }
+  } else {
+    std::span<const ElfRel<E>> rels1 = a.get_rels(ctx);
+    std::span<const ElfRel<E>> rels2 = b.get_rels(ctx);
+    for (i64 i = 0; i < rels1.size(); i++)
+      if (rels1[i].r_offset != rels2[i].r_offset ||
+          rels1[i].r_type != rels2[i].r_type ||
+          get_addend(a, rels1[i]) != get_addend(b, rels2[i]) ||
+          !is_same_symbol(*a.file.symbols[rels1[i].r_sym],
+                          *b.file.symbols[rels2[i].r_sym]))
+        return false;
+  }
+  return true;
+}
+
+// Digests are not cryptographic, so verify that each section is really
+// identical to its leader. If not (i.e. we had a hash collision), the
+// section is excluded from folding. Since excluding a section may make
+// sections referring to it different from their leaders, we repeat
+// until nothing changes.
+template <typename E>
+static void verify_leaders(Context<E> &ctx,
+                           std::span<InputSection<E> *> sections) {
+  Timer t(ctx, "verify");
+  static Counter collisions("icf_hash_collisions");
+
+  for (;;) {
+    tbb::concurrent_vector<InputSection<E> *> vec;
+
+    tbb::parallel_for_each(sections, [&](InputSection<E> *isec) {
+      if (isec->leader != isec && !is_same_section(ctx, *isec, *isec->leader))
+        vec.push_back(isec);
+    });
+
+    if (vec.empty())
+      return;
+
+    for (InputSection<E> *isec : vec)
+      isec->leader = isec;
+    collisions += vec.size();
+  }
+}
+
 template <typename E>
 static void print_icf_sections(Context<E> &ctx) {
   tbb::concurrent_vector<InputSection<E> *> leaders;
   tbb::concurrent_unordered_multimap<InputSection<E> *, InputSection<E> *> map;
 
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
+    for (InputSection<E> *isec : file->sections) {
       if (isec && isec->is_alive && isec->leader) {
-        if (isec.get() == isec->leader)
-          leaders.push_back(isec.get());
+        if (isec == isec->leader)
+          leaders.push_back(isec);
         else
-          map.insert({isec->leader, isec.get()});
+          map.insert({isec->leader, isec});
       }
     }
   });
@@ -563,7 +689,7 @@ void icf_sections(Context<E> &ctx) {
     }
   }
 
-  // Group sections by SHA digest.
+  // Group sections by digest.
   {
     Timer t(ctx, "group");
 
@@ -587,6 +713,8 @@ void icf_sections(Context<E> &ctx) {
     ctx.on_exit.push_back([=] { delete map; });
   }
 
+  verify_leaders<E>(ctx, sections);
+
   if (ctx.arg.print_icf_sections)
     print_icf_sections(ctx);
 
@@ -597,7 +725,7 @@ void icf_sections(Context<E> &ctx) {
     Timer t(ctx, "sweep");
     static Counter eliminated("icf_eliminated");
     tbb::parallel_for_each(ctx.objs, [](ObjectFile<E> *file) {
-      for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
+      for (InputSection<E> *isec : file->sections) {
         if (isec && isec->is_alive && isec->is_killed_by_icf()) {
           isec->kill();
           eliminated++;
@@ -2,6 +2,8 @@
 
 #include <bit>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <tbb/parallel_sort.h>
 
 #ifndef _WIN32
@@ -242,7 +244,7 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
 
       // Save .llvm_addrsig for --icf=safe.
       if (shdr.sh_type == SHT_LLVM_ADDRSIG && !ctx.arg.relocatable) {
-        llvm_addrsig = std::make_unique<InputSection<E>>(ctx, *this, name, i);
+        llvm_addrsig = ctx.arena.template make<InputSection<E>>(ctx, *this, name, i);
         continue;
       }
 
@@ -253,18 +255,21 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
       if (ctx.arg.oformat_binary && !(shdr.sh_flags & SHF_ALLOC))
         continue;
 
-      this->sections[i] = std::make_unique<InputSection<E>>(ctx, *this, name, i);
+      this->sections[i] =
+        ctx.arena.template make<InputSection<E>>(ctx, *this, name, i);
 
       if constexpr (is_ppc32<E>)
         if (name == ".got2")
-          ppc32_got2 = this->sections[i].get();
+          ppc32_got2 = this->sections[i];
 
-      // Save debug sections for --gdb-index.
-      if (ctx.arg.gdb_index) {
-        InputSection<E> *isec = this->sections[i].get();
+      // Save debug sections for --gdb-index and --debug-names.
+      if (ctx.arg.gdb_index || ctx.arg.debug_names) {
+        InputSection<E> *isec = this->sections[i];
 
         if (name == ".debug_info")
           debug_info = isec;
+        if (name == ".debug_abbrev")
+          debug_abbrev = isec;
         if (name == ".debug_ranges")
           debug_ranges = isec;
         if (name == ".debug_rnglists")
@@ -272,7 +277,8 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
 
         // If --gdb-index is given, contents of .debug_gnu_pubnames and
         // .debug_gnu_pubtypes are copied to .gdb_index, so keeping them
-        // in an output file is just a waste of space.
+        // in an output file is just a waste of space. The same is true
+        // for --debug-names.
         if (name == ".debug_gnu_pubnames") {
           debug_pubnames = isec;
           isec->is_alive = false;
@@ -283,12 +289,19 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
           isec->is_alive = false;
         }
 
+        // Per-compunit .debug_names are merged into a single output
+        // .debug_names if --debug-names is given.
+        if (name == ".debug_names" && ctx.arg.debug_names) {
+          debug_names = isec;
+          isec->is_alive = false;
+        }
+
         // .debug_types is similar to .debug_info but contains type info
         // only. It exists only in DWARF 4, has been removed in DWARF 5 and
         // neither GCC nor Clang generate it by default
         // (-fdebug-types-section is needed). As such there is probably
         // little need to support it.
-        if (name == ".debug_types")
+        if (name == ".debug_types" && ctx.arg.gdb_index)
           Fatal(ctx) << *this << ": mold's --gdb-index is not compatible"
             " with .debug_types; to fix this error, remove"
             " -fdebug-types-section and recompile";
@@ -311,7 +324,7 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
       Fatal(ctx) << *this << ": invalid relocated section index: "
                  << (u32)shdr.sh_info;
 
-    if (std::unique_ptr<InputSection<E>> &target = sections[shdr.sh_info]) {
+    if (InputSection<E> *target = sections[shdr.sh_info]) {
       assert(target->relsec_idx == -1);
       target->relsec_idx = i;
     }
@@ -321,7 +334,7 @@ void ObjectFile<E>::initialize_sections(Context<E> &ctx) {
 template <typename E>
 void ObjectFile<E>::initialize_ehframe_sections(Context<E> &ctx) {
   for (i64 i = 0; i < sections.size(); i++) {
-    std::unique_ptr<InputSection<E>> &isec = sections[i];
+    InputSection<E> *isec = sections[i];
     if (isec && isec->is_alive && isec->name() == ".eh_frame") {
       read_ehframe(ctx, *isec);
     }
@@ -466,7 +479,7 @@ void ObjectFile<E>::initialize_symbols(Context<E> &ctx) {
   counter += this->elf_syms.size();
 
   // Initialize local symbols
-  this->local_syms.resize(this->first_global);
+  this->local_syms = ctx.arena.template make_span<Symbol<E>>(this->first_global);
   this->local_syms[0].file = this;
   this->local_syms[0].sym_idx = 0;
 
@@ -488,7 +501,7 @@ void ObjectFile<E>::initialize_symbols(Context<E> &ctx) {
     sym.sym_idx = i;
 
     if (!esym.is_abs())
-      sym.set_input_section(sections[get_shndx(esym)].get());
+      sym.set_input_section(sections[get_shndx(esym)]);
   }
 
   this->symbols.resize(this->elf_syms.size());
@@ -536,7 +549,7 @@ void ObjectFile<E>::sort_relocations(Context<E> &ctx) {
     };
 
     for (i64 i = 1; i < sections.size(); i++) {
-      std::unique_ptr<InputSection<E>> &isec = sections[i];
+      InputSection<E> *isec = sections[i];
       if (!isec || !isec->is_alive || !(isec->shdr().sh_flags & SHF_ALLOC))
         continue;
 
@@ -558,6 +571,161 @@ static size_t find_null(std::string_view data, u64 entsize) {
   return data.npos;
 }
 
+// --parse-cache
+//
+// Splitting mergeable sections into fragments and hashing them is one
+// of the most expensive parts of reading object files. If --parse-cache
+// is given, we save the fragment boundaries and hashes of each object
+// file to a cache directory so that we can reuse them when we link the
+// same object file again.
+//
+// A cache file is named after a hash of the object file contents, the
+// mold version and the target, so an updated object file or a different
+// linker never reuses a stale entry. A cache file has the following
+// flat layout so that it can be read with a single read:
+//
+//   "MOLDPC1\0"
+//   For each mergeable section:
+//     u32 shndx
+//     u32 number of fragments (N)
+//     u32 fragment offsets[N] (padded to a multiple of 8 bytes)
+//     u64 fragment hashes[N]
+//   u32 -1 (terminator)
+
+static constexpr char PARSE_CACHE_MAGIC[8] = "MOLDPC1";
+
+namespace {
+struct ParseCacheEntry {
+  bool is_valid(i64 size) const {
+    if (offsets.empty() || offsets.size() != hashes.size() || offsets[0] != 0)
+      return false;
+    for (i64 i = 1; i < offsets.size(); i++)
+      if (offsets[i] <= offsets[i - 1])
+        return false;
+    return offsets.back() < size;
+  }
+
+  std::vector<u32> offsets;
+  std::vector<u64> hashes;
+};
+}
+
+template <typename E>
+static bool has_mergeable_section(ObjectFile<E> &file) {
+  for (InputSection<E> *isec : file.sections)
+    if (isec && isec->is_alive && (isec->shdr().sh_flags & SHF_MERGE) &&
+        isec->relsec_idx == -1)
+      return true;
+  return false;
+}
+
+template <typename E>
+static std::string get_parse_cache_path(Context<E> &ctx, ObjectFile<E> &file) {
+  std::string salt = mold_version_string + ":" + mold_git_hash + ":" +
+                     std::string(E::target_name);
+  std::string_view data = file.mf->get_contents();
+  XXH128_hash_t hash = XXH3_128bits_withSeed(data.data(), data.size(),
+                                             hash_string(salt));
+
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << hash.high64
+     << std::setw(16) << hash.low64;
+  return ctx.arg.parse_cache + "/" + ss.str();
+}
+
+// Reads a cache file. Returns an empty vector if the cache file does
+// not exist or is broken.
+static std::vector<ParseCacheEntry>
+read_parse_cache(const std::string &path, i64 num_sections) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return {};
+
+  std::string buf(in.tellg(), '\0');
+  in.seekg(0);
+  if (!in.read(buf.data(), buf.size()))
+    return {};
+  if (buf.size() < sizeof(PARSE_CACHE_MAGIC) ||
+      memcmp(buf.data(), PARSE_CACHE_MAGIC, sizeof(PARSE_CACHE_MAGIC)))
+    return {};
+
+  std::vector<ParseCacheEntry> vec(num_sections);
+  i64 pos = sizeof(PARSE_CACHE_MAGIC);
+
+  auto read32 = [&](u32 &val) {
+    if (pos + 4 > buf.size())
+      return false;
+    memcpy(&val, buf.data() + pos, 4);
+    pos += 4;
+    return true;
+  };
+
+  for (;;) {
+    u32 shndx, num_frags;
+    if (!read32(shndx))
+      return {};
+    if (shndx == -1)
+      return vec;
+    if (shndx >= num_sections || !read32(num_frags))
+      return {};
+
+    i64 offsets_size = align_to(num_frags * 4, 8);
+    if (pos + offsets_size + num_frags * 8 > buf.size())
+      return {};
+
+    ParseCacheEntry &ent = vec[shndx];
+    ent.offsets.resize(num_frags);
+    ent.hashes.resize(num_frags);
+    memcpy(ent.offsets.data(), buf.data() + pos, num_frags * 4);
+    memcpy(ent.hashes.data(), buf.data() + pos + offsets_size, num_frags * 8);
+    pos += offsets_size + num_frags * 8;
+  }
+}
+
+template <typename E>
+static void write_parse_cache(Context<E> &ctx, ObjectFile<E> &file,
+                              const std::string &path) {
+  std::string buf(PARSE_CACHE_MAGIC, sizeof(PARSE_CACHE_MAGIC));
+
+  auto write32 = [&](u32 val) {
+    buf.append((char *)&val, 4);
+  };
+
+  for (i64 i = 0; i < file.mergeable_sections.size(); i++) {
+    MergeableSection<E> *m = file.mergeable_sections[i];
+    if (!m || m->frag_offsets.empty())
+      continue;
+
+    write32(i);
+    write32(m->frag_offsets.size());
+    buf.append((char *)m->frag_offsets.data(), m->frag_offsets.size() * 4);
+    buf.resize(align_to(buf.size(), 8));
+    buf.append((char *)m->hashes.data(), m->hashes.size() * 8);
+  }
+  write32(-1);
+
+  // Write to a temporary file first and then rename it, so that
+  // concurrent mold processes never see a partially-written file.
+  static std::atomic_int32_t counter;
+  std::string tmp = path + ".tmp." + std::to_string(getpid()) + "." +
+                    std::to_string(counter++);
+
+  std::ofstream out(tmp, std::ios::binary);
+  if (!out) {
+    Warn(ctx) << "cannot write to parse cache " << path;
+    return;
+  }
+
+  out.write(buf.data(), buf.size());
+  out.close();
+
+  if (!out || rename(tmp.c_str(), path.c_str()) == -1) {
+    Warn(ctx) << "cannot write to parse cache " << path << ": "
+              << errno_string();
+    unlink(tmp.c_str());
+  }
+}
+
 // Mergeable sections (sections with SHF_MERGE bit) typically contain
 // string literals. Linker is expected to split the section contents
 // into null-terminated strings, merge them with mergeable strings
@@ -576,8 +744,9 @@ static size_t find_null(std::string_view data, u64 entsize) {
 //
 // We do not support mergeable sections that have relocations.
 template <typename E>
-static std::unique_ptr<MergeableSection<E>>
-split_section(Context<E> &ctx, InputSection<E> &sec) {
+static MergeableSection<E> *
+split_section(Context<E> &ctx, InputSection<E> &sec,
+              const ParseCacheEntry *cached) {
   if (!sec.is_alive || sec.relsec_idx != -1)
     return nullptr;
 
@@ -585,7 +754,7 @@ split_section(Context<E> &ctx, InputSection<E> &sec) {
   if (!(shdr.sh_flags & SHF_MERGE))
     return nullptr;
 
-  std::unique_ptr<MergeableSection<E>> rec(new MergeableSection<E>);
+  MergeableSection<E> *rec = ctx.arena.template make<MergeableSection<E>>();
   rec->parent = MergedSection<E>::get_instance(ctx, sec.name(), shdr.sh_type,
                                                shdr.sh_flags);
   rec->p2align = sec.p2align;
@@ -600,6 +769,26 @@ split_section(Context<E> &ctx, InputSection<E> &sec) {
   const char *begin = data.data();
   u64 entsize = shdr.sh_entsize;
   HyperLogLog estimator;
+  rec->contents = data;
+
+  // If the parse cache has fragment boundaries and hashes for this
+  // section, use them instead of scanning the section contents.
+  if (cached && cached->is_valid(data.size())) {
+    rec->frag_offsets = ctx.arena.template make_span<u32>(cached->offsets);
+    rec->hashes = ctx.arena.template make_span<u64>(cached->hashes);
+    for (u64 hash : cached->hashes)
+      estimator.insert(hash);
+
+    rec->parent->estimator.merge(estimator);
+    return rec;
+  }
+
+  // Fragment boundaries and hashes are first collected to thread-local
+  // buffers and then copied to the arena.
+  static thread_local std::vector<u32> frag_offsets;
+  static thread_local std::vector<u64> hashes;
+  frag_offsets.clear();
+  hashes.clear();
 
   // Split sections
   if (shdr.sh_flags & SHF_STRINGS) {
@@ -618,11 +807,10 @@ split_section(Context<E> &ctx, InputSection<E> &sec) {
       std::string_view substr = data.substr(0, end + entsize);
       data = data.substr(end + entsize);
 
-      rec->strings.push_back(substr);
-      rec->frag_offsets.push_back(substr.data() - begin);
+      frag_offsets.push_back(substr.data() - begin);
 
       u64 hash = hash_string(substr);
-      rec->hashes.push_back(hash);
+      hashes.push_back(hash);
       estimator.insert(hash);
     }
   } else {
@@ -638,19 +826,20 @@ split_section(Context<E> &ctx, InputSection<E> &sec) {
       std::string_view substr = data.substr(0, entsize);
       data = data.substr(entsize);
 
-      rec->strings.push_back(substr);
-      rec->frag_offsets.push_back(substr.data() - begin);
+      frag_offsets.push_back(substr.data() - begin);
 
       u64 hash = hash_string(substr);
-      rec->hashes.push_back(hash);
+      hashes.push_back(hash);
       estimator.insert(hash);
     }
   }
 
+  rec->frag_offsets = ctx.arena.template make_span<u32>(frag_offsets);
+  rec->hashes = ctx.arena.template make_span<u64>(hashes);
   rec->parent->estimator.merge(estimator);
 
   static Counter counter("string_fragments");
-  counter += rec->fragments.size();
+  counter += rec->frag_offsets.size();
   return rec;
 }
 
@@ -698,28 +887,45 @@ template <typename E>
 void ObjectFile<E>::initialize_mergeable_sections(Context<E> &ctx) {
   mergeable_sections.resize(sections.size());
 
+  std::vector<ParseCacheEntry> cache;
+  std::string cache_path;
+  bool use_cache = !ctx.arg.parse_cache.empty() && has_mergeable_section(*this);
+
+  if (use_cache) {
+    static Counter hits("parse_cache_hits");
+    static Counter misses("parse_cache_misses");
+
+    cache_path = get_parse_cache_path(ctx, *this);
+    cache = read_parse_cache(cache_path, sections.size());
+    if (cache.empty())
+      misses++;
+    else
+      hits++;
+  }
+
   for (i64 i = 0; i < sections.size(); i++) {
-    if (std::unique_ptr<InputSection<E>> &isec = sections[i]) {
-      if (std::unique_ptr<MergeableSection<E>> m = split_section(ctx, *isec)) {
-        mergeable_sections[i] = std::move(m);
+    if (InputSection<E> *isec = sections[i]) {
+      const ParseCacheEntry *cached = cache.empty() ? nullptr : &cache[i];
+      if (MergeableSection<E> *m = split_section(ctx, *isec, cached)) {
+        mergeable_sections[i] = m;
         isec->is_alive = false;
       }
     }
   }
+
+  if (use_cache && cache.empty())
+    write_parse_cache(ctx, *this, cache_path);
 }
 
 template <typename E>
 void ObjectFile<E>::resolve_section_pieces(Context<E> &ctx) {
-  for (std::unique_ptr<MergeableSection<E>> &m : mergeable_sections) {
+  for (MergeableSection<E> *m : mergeable_sections) {
     if (m) {
-      m->fragments.reserve(m->strings.size());
-      for (i64 i = 0; i < m->strings.size(); i++)
-        m->fragments.push_back(m->parent->insert(ctx, m->strings[i], m->hashes[i],
-                                                 m->p2align));
-
-      // Shrink vectors that we will never use again to reclaim memory.
-      m->strings.clear();
-      m->hashes.clear();
+      m->fragments =
+        ctx.arena.template make_span<SectionFragment<E> *>(m->frag_offsets.size());
+      for (i64 i = 0; i < m->frag_offsets.size(); i++)
+        m->fragments[i] = m->parent->insert(ctx, m->get_contents(i), m->hashes[i],
+                                            m->p2align);
     }
   }
 
@@ -731,7 +937,7 @@ void ObjectFile<E>::resolve_section_pieces(Context<E> &ctx) {
     if (esym.is_abs() || esym.is_common() || esym.is_undef())
       continue;
 
-    std::unique_ptr<MergeableSection<E>> &m = mergeable_sections[get_shndx(esym)];
+    MergeableSection<E> *m = mergeable_sections[get_shndx(esym)];
     if (!m || m->fragments.empty())
       continue;
 
@@ -748,20 +954,20 @@ void ObjectFile<E>::resolve_section_pieces(Context<E> &ctx) {
 
   // Compute the size of frag_syms.
   i64 nfrag_syms = 0;
-  for (std::unique_ptr<InputSection<E>> &isec : sections)
+  for (InputSection<E> *isec : sections)
     if (isec && isec->is_alive && (isec->shdr().sh_flags & SHF_ALLOC))
       for (ElfRel<E> &r : isec->get_rels(ctx))
         if (const ElfSym<E> &esym = this->elf_syms[r.r_sym];
             esym.st_type == STT_SECTION && mergeable_sections[get_shndx(esym)])
           nfrag_syms++;
 
-  this->frag_syms.resize(nfrag_syms);
+  this->frag_syms = ctx.arena.template make_span<Symbol<E>>(nfrag_syms);
 
   // For each relocation referring a mergeable section symbol, we create
   // a new dummy non-section symbol and redirect the relocation to the
   // newly-created symbol.
   i64 idx = 0;
-  for (std::unique_ptr<InputSection<E>> &isec : sections) {
+  for (InputSection<E> *isec : sections) {
     if (!isec || !isec->is_alive || !(isec->shdr().sh_flags & SHF_ALLOC))
       continue;
 
@@ -770,7 +976,7 @@ void ObjectFile<E>::resolve_section_pieces(Context<E> &ctx) {
       if (esym.st_type != STT_SECTION)
         continue;
 
-      std::unique_ptr<MergeableSection<E>> &m = mergeable_sections[get_shndx(esym)];
+      MergeableSection<E> *m = mergeable_sections[get_shndx(esym)];
       if (!m)
         continue;
 
@@ -991,7 +1197,7 @@ ObjectFile<E>::mark_live_objects(Context<E> &ctx,
 template <typename E>
 void ObjectFile<E>::scan_relocations(Context<E> &ctx) {
   // Scan relocations against seciton contents
-  for (std::unique_ptr<InputSection<E>> &isec : sections)
+  for (InputSection<E> *isec : sections)
     if (isec && isec->is_alive && (isec->shdr().sh_flags & SHF_ALLOC))
       isec->scan_relocations(ctx);
 
@@ -1066,17 +1272,17 @@ void ObjectFile<E>::convert_common_symbols(Context<E> &ctx) {
     shdr.sh_addralign = this->elf_syms[i].st_value;
 
     i64 idx = this->elf_sections.size() + elf_sections2.size() - 1;
-    std::unique_ptr<InputSection<E>> isec =
-      std::make_unique<InputSection<E>>(ctx, *this, name, idx);
+    InputSection<E> *isec =
+      ctx.arena.template make<InputSection<E>>(ctx, *this, name, idx);
 
     sym.file = this;
-    sym.set_input_section(isec.get());
+    sym.set_input_section(isec);
     sym.value = 0;
     sym.sym_idx = i;
     sym.ver_idx = ctx.default_version;
     sym.is_weak = false;
 
-    sections.push_back(std::move(isec));
+    sections.push_back(isec);
   }
 }
 
@@ -1158,6 +1364,7 @@ void ObjectFile<E>::populate_symtab(Context<E> &ctx) {
 
   u8 *strtab_base = ctx.buf + ctx.strtab->shdr.sh_offset;
   i64 strtab_off = this->strtab_offset;
+  i64 name_idx = 0;
 
   auto write_sym = [&](Symbol<E> &sym, i64 &symtab_idx) {
     U32<E> *xindex = nullptr;
@@ -1165,6 +1372,15 @@ void ObjectFile<E>::populate_symtab(Context<E> &ctx) {
       xindex = (U32<E> *)(ctx.buf + ctx.symtab_shndx->shdr.sh_offset +
                           symtab_idx * 4);
 
+    if (ctx.arg.strtab_dedup) {
+      i64 off = ctx.strtab->get_name_offset(*this, name_idx++);
+      symtab_base[symtab_idx++] = to_output_esym(ctx, sym, off, xindex);
+      if (off >= this->strtab_offset &&
+          off < this->strtab_offset + this->strtab_size)
+        write_string(strtab_base + off, sym.name());
+      return;
+    }
+
     symtab_base[symtab_idx++] = to_output_esym(ctx, sym, strtab_off, xindex);
     strtab_off += write_string(strtab_base + strtab_off, sym.name());
   };
@@ -1242,42 +1458,167 @@ void SharedFile<E>::parse(Context<E> &ctx) {
   version_strings = read_verdef(ctx);
 
   // Read a symbol table.
-  std::span<ElfSym<E>> esyms = this->template get_data<ElfSym<E>>(ctx, *symtab_sec);
+  dynsyms = this->template get_data<ElfSym<E>>(ctx, *symtab_sec);
 
-  std::span<U16<E>> vers;
   if (ElfShdr<E> *sec = this->find_section(SHT_GNU_VERSYM))
-    vers = this->template get_data<U16<E>>(ctx, *sec);
+    dynvers = this->template get_data<U16<E>>(ctx, *sec);
+
+  // If --lazy-dso-symbols is given, we intern only undefined symbols
+  // here. Defined symbols are interned later by intern_dso_symbols()
+  // only if they are referenced by other files.
+  if (ctx.arg.lazy_dso_symbols) {
+    if (ElfShdr<E> *sec = this->find_section(SHT_GNU_HASH)) {
+      hash_table = this->template get_data<U32<E>>(ctx, *sec);
+      is_gnu_hash = true;
+    } else if (ElfShdr<E> *sec = this->find_section(SHT_HASH)) {
+      hash_table = this->template get_data<U32<E>>(ctx, *sec);
+    }
+    is_lazy = !hash_table.empty();
+  }
 
-  for (i64 i = symtab_sec->sh_info; i < esyms.size(); i++) {
-    u16 ver;
-    if (vers.empty() || esyms[i].is_undef())
-      ver = VER_NDX_GLOBAL;
-    else
-      ver = (vers[i] & ~VERSYM_HIDDEN);
+  if (is_lazy) {
+    is_interned.resize(dynsyms.size());
+    for (i64 i = symtab_sec->sh_info; i < dynsyms.size(); i++)
+      if (dynsyms[i].is_undef())
+        add_symbol(ctx, i);
+  } else {
+    for (i64 i = symtab_sec->sh_info; i < dynsyms.size(); i++)
+      add_symbol(ctx, i);
+  }
 
-    if (ver == VER_NDX_LOCAL)
-      continue;
+  this->elf_syms = elf_syms2;
+  this->first_global = 0;
+}
+
+template <typename E>
+u16 SharedFile<E>::get_versym(i64 idx) {
+  if (dynvers.empty() || dynsyms[idx].is_undef())
+    return VER_NDX_GLOBAL;
+  return dynvers[idx] & ~VERSYM_HIDDEN;
+}
 
-    std::string_view name = this->symbol_strtab.data() + esyms[i].st_name;
-    bool is_hidden = (!vers.empty() && (vers[i] & VERSYM_HIDDEN));
+template <typename E>
+void SharedFile<E>::add_symbol(Context<E> &ctx, i64 idx) {
+  u16 ver = get_versym(idx);
+  if (ver == VER_NDX_LOCAL)
+    return;
 
-    this->elf_syms2.push_back(esyms[i]);
-    this->versyms.push_back(ver);
+  const ElfSym<E> &esym = dynsyms[idx];
+  std::string_view name = this->symbol_strtab.data() + esym.st_name;
+  bool is_hidden = (!dynvers.empty() && (dynvers[idx] & VERSYM_HIDDEN));
 
-    if (is_hidden) {
-      std::string_view mangled_name = save_string(
-        ctx, std::string(name) + "@" + std::string(version_strings[ver]));
-      this->symbols.push_back(get_symbol(ctx, mangled_name, name));
-    } else {
-      this->symbols.push_back(get_symbol(ctx, name));
-    }
+  this->elf_syms2.push_back(esym);
+  this->versyms.push_back(ver);
+
+  if (is_hidden) {
+    std::string_view mangled_name = save_string(
+      ctx, std::string(name) + "@" + std::string(version_strings[ver]));
+    this->symbols.push_back(get_symbol(ctx, mangled_name, name));
+  } else {
+    this->symbols.push_back(get_symbol(ctx, name));
   }
 
-  this->elf_syms = elf_syms2;
-  this->first_global = 0;
+  if (is_lazy)
+    is_interned.set(idx);
 
   static Counter counter("dso_syms");
-  counter += this->elf_syms.size();
+  counter++;
+}
+
+// Searches the DSO's .gnu.hash or .hash for a given symbol and appends
+// indices of matching defined symbols to a given vector. `key` is a
+// symbol name with an optional "@version" suffix.
+template <typename E>
+void SharedFile<E>::find_symbols(std::string_view key, std::string_view name,
+                                 tbb::concurrent_vector<u32> &vec) {
+  auto add = [&](u32 idx) {
+    if (idx < symtab_sec->sh_info || dynsyms.size() <= idx ||
+        is_interned.get(idx))
+      return;
+
+    const ElfSym<E> &esym = dynsyms[idx];
+    if (esym.is_undef() || name != this->symbol_strtab.data() + esym.st_name)
+      return;
+
+    u16 ver = get_versym(idx);
+    if (ver == VER_NDX_LOCAL)
+      return;
+
+    // A symbol of a hidden version can be referenced only as "foo@ver".
+    if (!dynvers.empty() && (dynvers[idx] & VERSYM_HIDDEN)) {
+      std::string_view verstr = version_strings[ver];
+      if (key.size() != name.size() + verstr.size() + 1 ||
+          key[name.size()] != '@' || !key.ends_with(verstr))
+        return;
+    }
+    vec.push_back(idx);
+  };
+
+  if (is_gnu_hash) {
+    // .gnu.hash consists of a header, a bloom filter, buckets and
+    // hash values of symbols.
+    constexpr i64 word_bits = sizeof(Word<E>) * 8;
+    u32 num_buckets = hash_table[0];
+    u32 sym_offset = hash_table[1];
+    u32 bloom_size = hash_table[2];
+    u32 bloom_shift = hash_table[3];
+
+    Word<E> *bloom = (Word<E> *)(hash_table.data() + 4);
+    U32<E> *buckets = (U32<E> *)(bloom + bloom_size);
+    U32<E> *chains = buckets + num_buckets;
+    u32 h = djb_hash(name);
+
+    u64 word = bloom[(h / word_bits) % bloom_size];
+    if (!((word >> (h % word_bits)) & (word >> ((h >> bloom_shift) % word_bits)) & 1))
+      return;
+
+    u32 idx = buckets[h % num_buckets];
+    if (idx < sym_offset)
+      return;
+
+    for (; idx < dynsyms.size(); idx++) {
+      u32 h2 = chains[idx - sym_offset];
+      if ((h | 1) == (h2 | 1))
+        add(idx);
+      if (h2 & 1)
+        break;
+    }
+  } else {
+    u32 num_buckets = hash_table[0];
+    U32<E> *buckets = hash_table.data() + 2;
+    U32<E> *chains = buckets + num_buckets;
+
+    for (u32 idx = buckets[elf_hash(name) % num_buckets];
+         idx && idx < dynsyms.size(); idx = chains[idx])
+      add(idx);
+  }
+}
+
+// Interns symbols found by find_symbols().
+template <typename E>
+void SharedFile<E>::intern_symbols(Context<E> &ctx,
+                                   std::span<const u32> indices) {
+  for (u32 idx : indices)
+    if (!is_interned.get(idx))
+      add_symbol(ctx, idx);
+
+  // If a data symbol is copied by a copy relocation, its aliases (i.e.
+  // symbols at the same address) have to be exported as well. See
+  // CopyrelSection::add_symbol. So we intern aliases of data symbols.
+  std::vector<u64> addrs;
+  for (ElfSym<E> &esym : elf_syms2)
+    if (esym.st_type == STT_OBJECT && !esym.is_undef())
+      addrs.push_back(esym.st_value);
+  sort(addrs);
+
+  if (!addrs.empty())
+    for (i64 i = symtab_sec->sh_info; i < dynsyms.size(); i++)
+      if (!is_interned.get(i) && !dynsyms[i].is_undef() &&
+          std::binary_search(addrs.begin(), addrs.end(),
+                             (u64)dynsyms[i].st_value))
+        add_symbol(ctx, i);
+
+  this->elf_syms = elf_syms2;
 }
 
 // Symbol versioning is a GNU extension to the ELF file format. I don't
@@ -1458,6 +1799,7 @@ void SharedFile<E>::populate_symtab(Context<E> &ctx) {
 
   u8 *strtab = ctx.buf + ctx.strtab->shdr.sh_offset;
   i64 strtab_off = this->strtab_offset;
+  i64 name_idx = 0;
 
   for (i64 i = 0, j = this->first_global; j < this->elf_syms.size(); i++, j++) {
     Symbol<E> &sym = *this->symbols[j];
@@ -1469,6 +1811,15 @@ void SharedFile<E>::populate_symtab(Context<E> &ctx) {
       xindex = (U32<E> *)(ctx.buf + ctx.symtab_shndx->shdr.sh_offset +
                           (this->global_symtab_idx + i) * 4);
 
+    if (ctx.arg.strtab_dedup) {
+      i64 off = ctx.strtab->get_name_offset(*this, name_idx++);
+      *symtab++ = to_output_esym(ctx, sym, off, xindex);
+      if (off >= this->strtab_offset &&
+          off < this->strtab_offset + this->strtab_size)
+        write_string(strtab + off, sym.name());
+      continue;
+    }
+
     *symtab++ = to_output_esym(ctx, sym, strtab_off, xindex);
     strtab_off += write_string(strtab + strtab_off, sym.name());
   }
@@ -1,6 +1,8 @@
 #include "mold.h"
 
 #include <limits>
+#include <tbb/concurrent_unordered_map.h>
+#include <tbb/parallel_for.h>
 #include <zlib.h>
 #include <zstd.h>
 
@@ -30,6 +32,75 @@ bool CieRecord<E>::equals(const CieRecord<E> &other) const {
   return true;
 }
 
+// Returns a hash value that is consistent with equals().
+template <typename E>
+u64 CieRecord<E>::get_hash() const {
+  u64 hash = hash_string(get_contents());
+  for (const ElfRel<E> &rel : get_rels()) {
+    hash = combine_hash(hash, rel.r_offset - input_offset);
+    hash = combine_hash(hash, rel.r_type);
+    hash = combine_hash(hash, (u64)file.symbols[rel.r_sym]);
+    hash = combine_hash(hash, get_addend(input_section, rel));
+  }
+  return hash;
+}
+
+template <typename E>
+struct CieHasher {
+  size_t operator()(CieRecord<E> *cie) const { return cie->get_hash(); }
+};
+
+template <typename E>
+struct CieEq {
+  bool operator()(CieRecord<E> *a, CieRecord<E> *b) const {
+    return a->equals(*b);
+  }
+};
+
+// Identical CIEs in different object files can be merged. This function
+// groups CIEs by their contents and relocation targets and returns one
+// representative for each group. The representative is the first one in
+// the file priority order, so the result is deterministic. Each CIE's
+// `leader_idx` is set to the index of its representative in the result.
+template <typename E>
+std::vector<CieRecord<E> *> uniquify_cies(Context<E> &ctx) {
+  Timer t(ctx, "uniquify_cies");
+
+  std::vector<CieRecord<E> *> cies;
+  for (ObjectFile<E> *file : ctx.objs)
+    for (CieRecord<E> &cie : file->cies)
+      cies.push_back(&cie);
+
+  // Find the first CIE of each group.
+  tbb::concurrent_unordered_map<CieRecord<E> *, Atomic<u32>,
+                                CieHasher<E>, CieEq<E>> map;
+
+  tbb::parallel_for((i64)0, (i64)cies.size(), [&](i64 i) {
+    auto [it, inserted] = map.insert({cies[i], i});
+    if (!inserted)
+      update_minimum(it->second, i);
+  });
+
+  std::vector<u32> first(cies.size());
+  tbb::parallel_for((i64)0, (i64)cies.size(), [&](i64 i) {
+    first[i] = map.find(cies[i])->second;
+  });
+
+  // Assign indices to representatives.
+  std::vector<CieRecord<E> *> leaders;
+  for (i64 i = 0; i < cies.size(); i++) {
+    if (first[i] == i) {
+      cies[i]->leader_idx = leaders.size();
+      cies[i]->is_leader = true;
+      leaders.push_back(cies[i]);
+    } else {
+      cies[i]->leader_idx = cies[first[i]]->leader_idx;
+      cies[i]->is_leader = false;
+    }
+  }
+  return leaders;
+}
+
 static i64 to_p2align(u64 alignment) {
   if (alignment == 0)
     return 0;
@@ -204,8 +275,19 @@ static void scan_rel(Context<E> &ctx, InputSection<E> &isec, Symbol<E> &sym,
     break;
   case BASEREL:
     check_textrel();
-    if (!isec.is_relr_reloc(ctx, rel))
+    if (!isec.is_relr_reloc(ctx, rel)) {
       isec.file.num_dynrel++;
+
+      // Report why a base relocation was not packed into .relr.dyn.
+      if (ctx.arg.pack_dyn_relocs_relr) {
+        static Counter unaligned("relr_rejected_unaligned");
+        static Counter section("relr_rejected_section");
+        if (rel.r_offset % sizeof(Word<E>))
+          unaligned++;
+        else
+          section++;
+      }
+    }
     break;
   case IFUNC:
     dynrel();
@@ -495,5 +577,6 @@ using E = MOLD_TARGET;
 
 template struct CieRecord<E>;
 template class InputSection<E>;
+template std::vector<CieRecord<E> *> uniquify_cies(Context<E> &);
 
 } // namespace mold::elf
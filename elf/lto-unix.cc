@@ -80,12 +80,17 @@
 
 #include "mold.h"
 #include "lto.h"
+#include "../common/filetype.h"
 
 #include <cstdarg>
 #include <cstring>
+#include <deque>
 #include <dlfcn.h>
 #include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
 #include <sstream>
+#include <sys/stat.h>
 #include <tbb/parallel_for_each.h>
 #include <unistd.h>
 
@@ -105,7 +110,9 @@ template <typename E> static Context<E> *gctx;
 template <typename E> static std::vector<ObjectFile<E> *> lto_objects;
 
 static int phase = 0;
-static std::vector<PluginSymbol> plugin_symbols;
+// add_symbols() is called back from claim_file_hook() on the same
+// thread, so we use a thread-local buffer to receive symbols.
+static thread_local std::vector<PluginSymbol> plugin_symbols;
 static ClaimFileHandler *claim_file_hook;
 static AllSymbolsReadHandler *all_symbols_read_hook;
 static CleanupHandler *cleanup_hook;
@@ -278,6 +285,29 @@ get_symbols_v1(const void *handle, int nsyms, PluginSymbol *psyms) {
 // that definition within the IR objects and remove the symbol from the
 // LTO result. On the other hand, if a definition is referenced by a
 // non-IR object, it has to keep the symbol in the LTO result.
+template <typename E>
+static PluginSymbolResolution
+get_resolution(ObjectFile<E> &file, const ElfSym<E> &esym, Symbol<E> &sym,
+               bool is_v2) {
+  if (!sym.file)
+    return LDPR_UNDEF;
+
+  if (sym.file == &file) {
+    if (sym.referenced_by_regular_obj)
+      return LDPR_PREVAILING_DEF;
+    if (sym.is_exported)
+      return is_v2 ? LDPR_PREVAILING_DEF : LDPR_PREVAILING_DEF_IRONLY_EXP;
+    return LDPR_PREVAILING_DEF_IRONLY;
+  }
+
+  if (sym.file->is_dso)
+    return LDPR_RESOLVED_DYN;
+
+  if (((ObjectFile<E> *)sym.file)->is_lto_obj && !sym.is_wrapped)
+    return esym.is_undef() ? LDPR_RESOLVED_IR : LDPR_PREEMPTED_IR;
+  return esym.is_undef() ? LDPR_RESOLVED_EXEC : LDPR_PREEMPTED_REG;
+}
+
 template <typename E>
 static PluginStatus
 get_symbols(const void *handle, int nsyms, PluginSymbol *psyms, bool is_v2) {
@@ -294,31 +324,11 @@ get_symbols(const void *handle, int nsyms, PluginSymbol *psyms, bool is_v2) {
     return LDPS_NO_SYMS;
   }
 
-  auto get_resolution = [&](ElfSym<E> &esym, Symbol<E> &sym) {
-    if (!sym.file)
-      return LDPR_UNDEF;
-
-    if (sym.file == &file) {
-      if (sym.referenced_by_regular_obj)
-        return LDPR_PREVAILING_DEF;
-      if (sym.is_exported)
-        return is_v2 ? LDPR_PREVAILING_DEF : LDPR_PREVAILING_DEF_IRONLY_EXP;
-      return LDPR_PREVAILING_DEF_IRONLY;
-    }
-
-    if (sym.file->is_dso)
-      return LDPR_RESOLVED_DYN;
-
-    if (((ObjectFile<E> *)sym.file)->is_lto_obj && !sym.is_wrapped)
-      return esym.is_undef() ? LDPR_RESOLVED_IR : LDPR_PREEMPTED_IR;
-    return esym.is_undef() ? LDPR_RESOLVED_EXEC : LDPR_PREEMPTED_REG;
-  };
-
   // Set the symbol resolution results to psyms.
   for (i64 i = 0; i < nsyms; i++) {
     ElfSym<E> &esym = file.elf_syms[i + 1];
     Symbol<E> &sym = *file.symbols[i + 1];
-    psyms[i].resolution = get_resolution(esym, sym);
+    psyms[i].resolution = get_resolution(file, esym, sym, is_v2);
   }
   return LDPS_OK;
 }
@@ -575,48 +585,131 @@ static bool supports_v3_api(Context<E> &ctx) {
   return is_gcc_linker_api_v1 || is_llvm(ctx);
 }
 
+// IR files whose claims are deferred until symbol resolution is done.
+// See read_gcc_lto_symtab() for details.
+template <typename E> static std::vector<ObjectFile<E> *> deferred_lto_objects;
+
+// IR files that have been passed to the plugin immediately.
+template <typename E> static std::vector<ObjectFile<E> *> claimed_lto_objects;
+
+// Old GCC linker plugins don't support the get_symbols_v3 API, and
+// there's no way to tell them to ignore an IR file that we claimed
+// but ended up not including into the output (e.g. an unused archive
+// member). We used to work around it by restarting the linker with a
+// list of files to ignore (see restart_process()).
+//
+// To avoid the restart, we read a GCC IR file's symbol table ourselves
+// without calling the plugin, and pass the file to the plugin only if
+// it turns out to be live after symbol resolution. GCC IR files are
+// ELF files containing a symbol table in a .gnu.lto_.symtab.* section
+// with the following entries:
+//
+//   char name[]       (null-terminated)
+//   char comdat_key[] (null-terminated)
+//   u8   kind         (DEF, WEAKDEF, UNDEF, WEAKUNDEF or COMMON)
+//   u8   visibility   (DEFAULT, PROTECTED, INTERNAL or HIDDEN)
+//   u64  size
+//   u32  slot
+//
+// Returns false if the file doesn't look like a GCC IR file we can read.
 template <typename E>
-ObjectFile<E> *read_lto_object(Context<E> &ctx, MappedFile<Context<E>> *mf) {
-  // V0 API's claim_file is not thread-safe.
-  static std::mutex mu;
-  std::unique_lock lock(mu, std::defer_lock);
-  if (!is_gcc_linker_api_v1)
-    lock.lock();
+static bool read_gcc_lto_symtab(Context<E> &ctx, ObjectFile<E> *obj) {
+  MappedFile<Context<E>> *mf = obj->mf;
+  if (get_file_type(ctx, mf) != FileType::GCC_LTO_OBJ)
+    return false;
+
+  std::string_view data = mf->get_contents();
+  ElfEhdr<E> &ehdr = *(ElfEhdr<E> *)data.data();
+  if (ehdr.e_shnum == 0 || ehdr.e_shstrndx == SHN_XINDEX ||
+      ehdr.e_shoff + ehdr.e_shnum * sizeof(ElfShdr<E>) > data.size())
+    return false;
+
+  std::span<ElfShdr<E>> shdrs{(ElfShdr<E> *)(data.data() + ehdr.e_shoff),
+                              ehdr.e_shnum};
+  if (ehdr.e_shstrndx >= shdrs.size())
+    return false;
+
+  ElfShdr<E> &shstrtab = shdrs[ehdr.e_shstrndx];
+  if (shstrtab.sh_offset + shstrtab.sh_size > data.size())
+    return false;
+
+  // Find the symbol table section. We don't handle files with more
+  // than one symbol table (e.g. files for offloading).
+  std::string_view symtab;
+  for (ElfShdr<E> &shdr : shdrs) {
+    if (shdr.sh_name >= shstrtab.sh_size)
+      return false;
+    const char *p = data.data() + shstrtab.sh_offset + shdr.sh_name;
+    std::string_view name(p, strnlen(p, shstrtab.sh_size - shdr.sh_name));
+    if (!name.starts_with(".gnu.lto_.symtab"))
+      continue;
+    if (!symtab.empty() || shdr.sh_offset + shdr.sh_size > data.size())
+      return false;
+    symtab = data.substr(shdr.sh_offset, shdr.sh_size);
+  }
 
-  if (ctx.arg.plugin.empty())
-    Fatal(ctx) << mf->name << ": don't know how to handle this LTO object file "
-               << "because no -plugin option was given. Please make sure you "
-               << "added -flto not only for creating object files but also for "
-               << "creating the final executable.";
+  if (symtab.empty())
+    return false;
 
-  // dlopen the linker plugin file
-  static std::once_flag flag;
-  std::call_once(flag, [&] { load_plugin(ctx); });
+  std::unique_ptr<std::vector<ElfSym<E>>> esyms(new std::vector<ElfSym<E>>(1));
 
-  // Create mold's object instance
-  ObjectFile<E> *obj = new ObjectFile<E>;
-  ctx.obj_pool.emplace_back(obj);
+  while (!symtab.empty()) {
+    size_t pos = symtab.find('\0');
+    if (pos == symtab.npos)
+      return false;
+    std::string_view name = symtab.substr(0, pos);
+    symtab = symtab.substr(pos + 1);
 
-  obj->filename = mf->name;
-  obj->symbols.push_back(new Symbol<E>);
-  obj->first_global = 1;
-  obj->is_lto_obj = true;
-  obj->mf = mf;
+    pos = symtab.find('\0');
+    if (pos == symtab.npos || symtab.size() < pos + 15)
+      return false;
+    symtab = symtab.substr(pos + 1);
+
+    PluginSymbol psym = {};
+    psym.def = (u8)symtab[0];
+    psym.visibility = (u8)symtab[1];
+    memcpy(&psym.size, symtab.data() + 2, 8);
+    symtab = symtab.substr(14);
+
+    if (psym.def > LDPK_COMMON || psym.visibility > LDPV_HIDDEN)
+      return false;
+
+    esyms->push_back(to_elf_sym<E>(psym));
+    obj->symbols.push_back(get_symbol(ctx, name));
+  }
+
+  obj->has_symver.resize(esyms->size());
+  obj->elf_syms = *esyms.release();
+  return true;
+}
+
+// Reads the symbol table of an IR object by calling claim_file_hook.
+template <typename E>
+static void claim_file(Context<E> &ctx, ObjectFile<E> *obj) {
+  MappedFile<Context<E>> *mf = obj->mf;
 
   // Create plugin's object instance
   PluginInputFile file = {};
 
   MappedFile<Context<E>> *mf2 = mf->parent ? mf->parent : mf;
   file.name = save_string(ctx, mf2->name).data();
-  if (mf2->fd == -1)
-    mf2->fd = open(file.name, O_RDONLY);
-  file.fd = mf2->fd;
+
+  // It looks like GCC doesn't need fd after claim_file_hook() while
+  // LLVM needs it and takes the ownership of fd. To prevent "too many
+  // open files" issue, we open a temporary fd only for GCC. This is
+  // ugly, though. Since GCC may claim files concurrently, we don't share
+  // an fd between archive members in that case.
+  if (is_llvm(ctx)) {
+    if (mf2->fd == -1)
+      mf2->fd = open(file.name, O_RDONLY);
+    file.fd = mf2->fd;
+  } else {
+    file.fd = open(file.name, O_RDONLY);
+  }
+
   if (file.fd == -1)
     Fatal(ctx) << "cannot open " << file.name << ": " << errno_string();
 
-  if (mf->parent)
-    obj->archive_name = mf->parent->name;
-
   file.offset = mf->get_offset();
   file.filesize = mf->size;
   file.handle = (void *)obj;
@@ -631,13 +724,8 @@ ObjectFile<E> *read_lto_object(Context<E> &ctx, MappedFile<Context<E>> *mf) {
                << " please make sure you are using the same compiler of the"
                << " same version for all object files";
 
-  // It looks like GCC doesn't need fd after claim_file_hook() while
-  // LLVM needs it and takes the ownership of fd. To prevent "too many
-  // open files" issue, we close fd only for GCC. This is ugly, though.
-  if (!is_llvm(ctx)) {
-    close(mf2->fd);
-    mf2->fd = -1;
-  }
+  if (!is_llvm(ctx))
+    close(file.fd);
 
   // Initialize object symbols
   std::vector<ElfSym<E>> *esyms = new std::vector<ElfSym<E>>(1);
@@ -650,16 +738,358 @@ ObjectFile<E> *read_lto_object(Context<E> &ctx, MappedFile<Context<E>> *mf) {
   obj->elf_syms = *esyms;
   obj->has_symver.resize(esyms->size());
   plugin_symbols.clear();
+}
+
+// V0 API's claim_file_hook is not thread-safe, so we have to call it
+// for one file at a time. Instead of making the main thread wait for
+// the plugin, we push IR files to a queue and claim them in a background
+// task. At most one worker thread is occupied by the plugin, and the
+// other threads keep parsing regular ELF files in the meantime.
+template <typename E>
+static void claim_file_serially(Context<E> &ctx, ObjectFile<E> *obj) {
+  static std::mutex mu;
+  static std::deque<ObjectFile<E> *> queue;
+  static bool running = false;
+
+  std::scoped_lock lock(mu);
+  queue.push_back(obj);
+  if (running)
+    return;
+  running = true;
+
+  ctx.tg.run([&ctx] {
+    for (;;) {
+      ObjectFile<E> *obj;
+      {
+        std::scoped_lock lock(mu);
+        if (queue.empty()) {
+          running = false;
+          return;
+        }
+        obj = queue.front();
+        queue.pop_front();
+      }
+      claim_file(ctx, obj);
+    }
+  });
+}
+
+// Creates an object file for a given IR file. Its symbol table is
+// filled asynchronously and becomes available after `ctx.tg.wait()`.
+template <typename E>
+ObjectFile<E> *read_lto_object(Context<E> &ctx, MappedFile<Context<E>> *mf) {
+  if (ctx.arg.plugin.empty())
+    Fatal(ctx) << mf->name << ": don't know how to handle this LTO object file "
+               << "because no -plugin option was given. Please make sure you "
+               << "added -flto not only for creating object files but also for "
+               << "creating the final executable.";
+
+  // dlopen the linker plugin file
+  static std::once_flag flag;
+  std::call_once(flag, [&] { load_plugin(ctx); });
+
+  // Create mold's object instance
+  ObjectFile<E> *obj = new ObjectFile<E>;
+  ctx.obj_pool.emplace_back(obj);
+
+  obj->filename = mf->name;
+  obj->symbols.push_back(new Symbol<E>);
+  obj->first_global = 1;
+  obj->is_lto_obj = true;
+  obj->mf = mf;
+
+  if (mf->parent)
+    obj->archive_name = mf->parent->name;
+
+  if (!supports_v3_api(ctx) && !ctx.arg.lto_pass2) {
+    if (read_gcc_lto_symtab(ctx, obj)) {
+      deferred_lto_objects<E>.push_back(obj);
+      return obj;
+    }
+
+    // Roll back a partially-read symbol table.
+    obj->symbols.resize(1);
+    claimed_lto_objects<E>.push_back(obj);
+  }
+
+  // GCC's V1 API guarantees that claim_file_hook is thread-safe.
+  if (is_gcc_linker_api_v1)
+    ctx.tg.run([&ctx, obj] { claim_file(ctx, obj); });
+  else
+    claim_file_serially(ctx, obj);
   return obj;
 }
 
+// Passes live IR files whose claims have been deferred to the plugin.
+// Returns false if the plugin reported a symbol list that differs from
+// the one we read, as our symbol resolution result would be invalid.
+template <typename E>
+static bool claim_deferred_files(Context<E> &ctx) {
+  Timer t(ctx, "claim_deferred_files");
+  bool ok = true;
+
+  for (ObjectFile<E> *file : deferred_lto_objects<E>) {
+    if (!file->is_alive)
+      continue;
+
+    std::vector<Symbol<E> *> syms = file->symbols;
+    file->symbols.resize(1);
+    claim_file(ctx, file);
+    if (file->symbols != syms)
+      ok = false;
+  }
+  return ok;
+}
+
+// --lto-cache-dir
+//
+// Unlike ThinLTO, GCC LTO and LLVM's full LTO don't have a cache, so the
+// compiler backend recompiles all IR files on every link even if nothing
+// has changed. If --lto-cache-dir is given, we save ELF files returned
+// by the plugin to a cache directory, keyed by everything that can
+// affect the LTO result: the contents of the live IR files, their symbol
+// resolution results, plugin options, the compiler options GCC passes
+// via COLLECT_GCC_OPTIONS and the plugin itself. If we find
+// an entry for the same key, we skip the plugin and use cached files.
+//
+// Each cache entry is a directory containing "0.o", "1.o", and so on.
+// The cache size is bounded by --lto-cache-max-size. When the limit is
+// exceeded, least recently used entries are removed.
+
+template <typename E>
+static bool is_lto_cache_enabled(Context<E> &ctx) {
+  if (ctx.arg.lto_cache_dir.empty())
+    return false;
+
+  // These options make the plugin emit something other than object files.
+  for (std::string_view opt : ctx.arg.plugin_opt)
+    if (opt == "emit-llvm" || opt == "emit-asm" ||
+        opt.starts_with("thinlto-index-only"))
+      return false;
+  return true;
+}
+
+// GCC passes code generation options such as -O2 or -march to
+// lto-wrapper via the COLLECT_GCC_OPTIONS environment variable, which
+// contains single-quoted arguments (e.g. "'-flto' '-O2' '-o' 'a.out'").
+// This function returns the options except the ones that only name
+// output files.
+static std::vector<std::string> get_collect_gcc_options() {
+  char *env = getenv("COLLECT_GCC_OPTIONS");
+  if (!env)
+    return {};
+
+  std::vector<std::string> vec;
+  std::string cur;
+  bool in_arg = false;
+
+  for (char *p = env; *p; p++) {
+    if (*p == '\'') {
+      p++;
+      while (*p && *p != '\'')
+        cur += *p++;
+      in_arg = true;
+      if (!*p)
+        break;
+    } else if (*p == '\\' && p[1]) {
+      cur += *++p;
+      in_arg = true;
+    } else if (*p == ' ') {
+      if (in_arg)
+        vec.push_back(cur);
+      cur.clear();
+      in_arg = false;
+    }
+  }
+  if (in_arg)
+    vec.push_back(cur);
+
+  std::vector<std::string> ret;
+  for (i64 i = 0; i < vec.size(); i++) {
+    if (vec[i] == "-o" || vec[i] == "-dumpdir" || vec[i] == "-dumpbase" ||
+        vec[i] == "-dumpbase-ext")
+      i++;
+    else
+      ret.push_back(vec[i]);
+  }
+  return ret;
+}
+
+template <typename E>
+static std::string get_lto_cache_path(Context<E> &ctx) {
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+
+  auto update = [&](std::string_view str) {
+    u64 size = str.size();
+    XXH3_128bits_update(&state, &size, sizeof(size));
+    XXH3_128bits_update(&state, str.data(), str.size());
+  };
+
+  update(mold_version_string);
+  update(mold_git_hash);
+  update(E::target_name);
+  update(ctx.arg.shared ? "shared" : ctx.arg.pie ? "pie" : "exec");
+
+  // Identify a program by its path, size and modification time.
+  auto update_file_id = [&](const std::string &path) {
+    update(path);
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+      update(std::to_string(st.st_size) + ":" + std::to_string(st.st_mtime));
+  };
+
+  update_file_id(ctx.arg.plugin);
+
+  // GCC's plugin takes a path to lto-wrapper as a plugin option. The
+  // resolution file is a temporary file whose name is different on
+  // each run, so it's excluded.
+  for (std::string_view opt : ctx.arg.plugin_opt) {
+    if (opt.starts_with("-fresolution="))
+      continue;
+    if (opt.starts_with("/"))
+      update_file_id(std::string(opt));
+    else
+      update(opt);
+  }
+
+  if (char *env = getenv("COLLECT_GCC"))
+    update(env);
+  for (std::string_view opt : get_collect_gcc_options())
+    update(opt);
+
+  bool is_v2 = !supports_v3_api(ctx);
+
+  for (ObjectFile<E> *file : ctx.objs) {
+    if (!file->is_lto_obj)
+      continue;
+
+    update(file->mf->get_contents());
+
+    std::string buf;
+    for (i64 i = 1; i < file->elf_syms.size(); i++) {
+      Symbol<E> &sym = *file->symbols[i];
+      buf += (char)get_resolution(*file, file->elf_syms[i], sym, is_v2);
+      buf += (char)sym.visibility;
+    }
+    update(buf);
+  }
+
+  XXH128_hash_t hash = XXH3_128bits_digest(&state);
+
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << hash.high64
+     << std::setw(16) << hash.low64;
+  return ctx.arg.lto_cache_dir + "/" + ss.str();
+}
+
+// Reads ELF files from a cache entry. Returns false on cache miss.
+template <typename E>
+static bool read_lto_cache(Context<E> &ctx, const std::string &path) {
+  namespace fs = std::filesystem;
+
+  std::error_code ec;
+  if (!fs::is_directory(path, ec))
+    return false;
+
+  for (i64 i = 0;; i++) {
+    std::string file = path + "/" + std::to_string(i) + ".o";
+    if (!fs::exists(file, ec))
+      break;
+    add_input_file<E>(file.c_str());
+  }
+
+  // Update the timestamp for LRU eviction.
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+  return true;
+}
+
+// Removes least recently used entries until the total size of the
+// cache directory gets below the limit.
+template <typename E>
+static void prune_lto_cache(Context<E> &ctx) {
+  namespace fs = std::filesystem;
+
+  struct Entry {
+    fs::path path;
+    fs::file_time_type time;
+    i64 size = 0;
+  };
+
+  std::error_code ec;
+  std::vector<Entry> entries;
+  i64 total = 0;
+
+  for (const fs::directory_entry &dir :
+       fs::directory_iterator(ctx.arg.lto_cache_dir, ec)) {
+    if (!dir.is_directory(ec) ||
+        dir.path().filename().string().find(".tmp.") != std::string::npos)
+      continue;
+
+    Entry ent{dir.path(), dir.last_write_time(ec)};
+    for (const fs::directory_entry &file : fs::directory_iterator(dir, ec))
+      ent.size += file.file_size(ec);
+    total += ent.size;
+    entries.push_back(ent);
+  }
+
+  sort(entries, [](const Entry &a, const Entry &b) { return a.time < b.time; });
+
+  for (Entry &ent : entries) {
+    if (total <= ctx.arg.lto_cache_max_size)
+      break;
+    fs::remove_all(ent.path, ec);
+    total -= ent.size;
+  }
+}
+
+// Saves ELF files returned by the plugin to a new cache entry.
+template <typename E>
+static void write_lto_cache(Context<E> &ctx, const std::string &path) {
+  namespace fs = std::filesystem;
+
+  // We copy files instead of writing mmap'ed contents because the
+  // linker may have modified them in memory (e.g. sorted relocations).
+  // We create an entry as a temporary directory and rename it, so that
+  // other processes never see a partially-written entry.
+  std::string tmp = path + ".tmp." + std::to_string(getpid());
+  std::error_code ec;
+  fs::create_directories(tmp, ec);
+
+  for (i64 i = 0; i < lto_objects<E>.size() && !ec; i++)
+    fs::copy_file(lto_objects<E>[i]->mf->name,
+                  tmp + "/" + std::to_string(i) + ".o",
+                  fs::copy_options::overwrite_existing, ec);
+
+  if (!ec)
+    fs::rename(tmp, path, ec);
+
+  if (ec) {
+    // Another process may have created the same entry. That's not an error.
+    if (!fs::is_directory(path))
+      Warn(ctx) << "cannot write to LTO cache " << path << ": " << ec.message();
+    fs::remove_all(tmp, ec);
+    return;
+  }
+
+  prune_lto_cache(ctx);
+}
+
 // Entry point
 template <typename E>
 std::vector<ObjectFile<E> *> do_lto(Context<E> &ctx) {
   Timer t(ctx, "do_lto");
 
-  if (!ctx.arg.lto_pass2 && !supports_v3_api(ctx))
-    restart_process(ctx);
+  if (!ctx.arg.lto_pass2 && !supports_v3_api(ctx)) {
+    bool ok = claim_deferred_files(ctx);
+
+    for (ObjectFile<E> *file : claimed_lto_objects<E>)
+      if (!file->is_alive)
+        ok = false;
+
+    if (!ok)
+      restart_process(ctx);
+  }
 
   assert(phase == 1);
   phase = 2;
@@ -692,11 +1122,21 @@ std::vector<ObjectFile<E> *> do_lto(Context<E> &ctx) {
     get_symbol(ctx, y)->referenced_by_regular_obj = true;
   }
 
+  std::string cache_path;
+  if (is_lto_cache_enabled(ctx)) {
+    Timer t(ctx, "lto_cache");
+    cache_path = get_lto_cache_path(ctx);
+    if (read_lto_cache(ctx, cache_path))
+      return lto_objects<E>;
+  }
+
   // all_symbols_read_hook() calls add_input_file() and add_input_library()
   LOG << "all symbols read\n";
   if (PluginStatus st = all_symbols_read_hook(); st != LDPS_OK)
     Fatal(ctx) << "LTO: all_symbols_read_hook returns " << st;
 
+  if (!cache_path.empty())
+    write_lto_cache(ctx, cache_path);
   return lto_objects<E>;
 }
 
@@ -454,6 +454,10 @@ int elf_main(int argc, char **argv) {
   if (!ctx.arg.relocatable)
     create_internal_file(ctx);
 
+  // Handle --lazy-dso-symbols.
+  if (ctx.arg.lazy_dso_symbols)
+    intern_dso_symbols(ctx);
+
   // resolve_symbols is 4 things in 1 phase:
   //
   // - Determine the set of object files to extract from archives.
@@ -496,6 +500,11 @@ int elf_main(int argc, char **argv) {
   if (ctx.arg.icf && !ctx.arg.icf_all)
     mark_addrsig(ctx);
 
+  // Decode relocations in advance so that the following passes don't
+  // have to read them from input files again and again.
+  if (ctx.arg.relocation_cache)
+    decode_relocations(ctx);
+
   // Garbage-collect unreachable sections.
   if (ctx.arg.gc_sections)
     gc_sections(ctx);
@@ -504,9 +513,17 @@ int elf_main(int argc, char **argv) {
   if (ctx.arg.icf)
     icf_sections(ctx);
 
+  // Remove debug info of object files whose code and data are all removed.
+  if (ctx.arg.discard_dead_object_debug_info)
+    discard_dead_object_debug_info(ctx);
+
   // Compute sizes of sections containing mergeable strings.
   compute_merged_section_sizes(ctx);
 
+  // Handle --pack-dyn-relocs=auto
+  if (ctx.arg.pack_dyn_relocs_auto)
+    ctx.arg.pack_dyn_relocs_relr = ctx.arg.pic && find_glibc_dt_relr_dso(ctx);
+
   // Create linker-synthesized sections such as .got or .plt.
   create_synthetic_sections(ctx);
 
@@ -533,6 +550,10 @@ int elf_main(int argc, char **argv) {
   if (ctx.arg.z_cet_report != CET_REPORT_NONE)
     check_cet_errors(ctx);
 
+  // .plt.got entries don't have to start with endbr64 if IBT is disabled.
+  if constexpr (is_x86_64<E>)
+    ctx.extra.compact_pltgot = ctx.arg.z_now && !is_ibt_enabled(ctx);
+
   // Handle `-z execstack-if-needed`.
   if (ctx.arg.z_execstack_if_needed)
     for (ObjectFile<E> *file : ctx.objs)
@@ -594,6 +615,10 @@ int elf_main(int argc, char **argv) {
   // .got.plt, .dynsym, .dynstr, etc.
   scan_relocations(ctx);
 
+  // Handle --cluster-dynrels
+  if (ctx.arg.cluster_dynrels && !ctx.arg.relocatable)
+    cluster_dynrel_sections(ctx);
+
   // Compute sizes of output sections while assigning offsets
   // within an output section to input sections.
   compute_section_sizes(ctx);
@@ -624,6 +649,11 @@ int elf_main(int argc, char **argv) {
   // Fill .gnu.version_r section contents.
   ctx.verneed->construct(ctx);
 
+  // Handle --binding-cache. This has to be done after .gnu.version_r
+  // because it refers to version strings in .dynstr.
+  if (ctx.binding_cache)
+    ctx.binding_cache->construct(ctx);
+
   // Compute .symtab and .strtab sizes for each file.
   create_output_symtab(ctx);
 
@@ -637,6 +667,10 @@ int elf_main(int argc, char **argv) {
   if (ctx.arg.gdb_index)
     ctx.gdb_index->construct(ctx);
 
+  // Handle --debug-names.
+  if (ctx.arg.debug_names)
+    ctx.debug_names->construct(ctx);
+
   // If --emit-relocs is given, we'll copy relocation sections from input
   // files to an output file.
   if (ctx.arg.emit_relocs)
@@ -668,6 +702,11 @@ int elf_main(int argc, char **argv) {
   if (ctx.arg.compress_debug_sections != COMPRESS_NONE)
     filesize = compress_debug_sections(ctx);
 
+  // If --separate-debug-file is given, move debug sections out of the
+  // main output.
+  if (!ctx.arg.separate_debug_file.empty())
+    filesize = separate_debug_sections(ctx);
+
   // At this point, both memory and file layouts are fixed.
 
   t_before_copy.stop();
@@ -701,6 +740,12 @@ int elf_main(int argc, char **argv) {
   if (ctx.buildid)
     ctx.buildid->write_buildid(ctx);
 
+  // The debug file contains a copy of the build ID, and the main
+  // output contains the debug file's CRC32, so finish the debug file
+  // after computing the build ID.
+  if (ctx.debug_file)
+    finish_separate_debug_file(ctx);
+
   t_copy.stop();
   ctx.checkpoint();
 
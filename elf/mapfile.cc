@@ -1,55 +1,193 @@
 #include "mold.h"
 
 #include <fstream>
-#include <iomanip>
-#include <ios>
 #include <sstream>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
-#include <unordered_map>
 
 namespace mold::elf {
 
+// Symbols defined by a file, grouped by the input section they belong
+// to and sorted by address within each group. Symbols for section
+// `shndx` are in `syms[begin[shndx]]` to `syms[begin[shndx + 1] - 1]`.
 template <typename E>
-using Map =
-  tbb::concurrent_hash_map<InputSection<E> *, std::vector<Symbol<E> *>>;
+struct FileSymbols {
+  std::string filename;
+  std::vector<Symbol<E> *> syms;
+  std::vector<u32> begin;
+};
 
 template <typename E>
-static std::unique_ptr<std::ofstream> open_output_file(Context<E> &ctx) {
-  std::unique_ptr<std::ofstream> file(new std::ofstream);
-  file->open(ctx.arg.Map.c_str());
-  if (!file->is_open())
-    Fatal(ctx) << "cannot open " << ctx.arg.Map << ": " << errno_string();
-  return file;
-}
+class SymbolTable {
+public:
+  SymbolTable(Context<E> &ctx);
+
+  const FileSymbols<E> &get_file(InputSection<E> &isec) const {
+    return files[isec.file.priority];
+  }
+
+  std::span<Symbol<E> *const> get_symbols(InputSection<E> &isec) const {
+    const FileSymbols<E> &fs = get_file(isec);
+    if (fs.begin.empty())
+      return {};
+    u32 begin = fs.begin[isec.shndx];
+    u32 end = fs.begin[isec.shndx + 1];
+    return std::span(fs.syms).subspan(begin, end - begin);
+  }
+
+private:
+  // Indexed by file priority, which is unique and small for each file.
+  std::vector<FileSymbols<E>> files;
+};
 
 template <typename E>
-static Map<E> get_map(Context<E> &ctx) {
-  Map<E> map;
+SymbolTable<E>::SymbolTable(Context<E> &ctx) {
+  i64 max_priority = 0;
+  for (ObjectFile<E> *file : ctx.objs)
+    max_priority = std::max<i64>(max_priority, file->priority);
+  files.resize(max_priority + 1);
 
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
-    for (Symbol<E> *sym : file->symbols) {
+    FileSymbols<E> &fs = files[file->priority];
+
+    std::ostringstream ss;
+    ss << *file;
+    fs.filename = ss.str();
+
+    auto get_isec = [&](Symbol<E> *sym) -> InputSection<E> * {
       if (sym->file != file || sym->get_type() == STT_SECTION)
-        continue;
-
-      if (InputSection<E> *isec = sym->get_input_section()) {
-        assert(file == &isec->file);
-        typename Map<E>::accessor acc;
-        map.insert(acc, {isec, {}});
-        acc->second.push_back(sym);
-      }
-    }
+        return nullptr;
+      return sym->get_input_section();
+    };
+
+    // Bucket symbols by section index with a counting sort.
+    fs.begin.resize(file->sections.size() + 1);
+    for (Symbol<E> *sym : file->symbols)
+      if (InputSection<E> *isec = get_isec(sym))
+        fs.begin[isec->shndx + 1]++;
+
+    for (i64 i = 1; i < fs.begin.size(); i++)
+      fs.begin[i] += fs.begin[i - 1];
+
+    fs.syms.resize(fs.begin.back());
+    std::vector<u32> pos(fs.begin.begin(), fs.begin.end() - 1);
+
+    for (Symbol<E> *sym : file->symbols)
+      if (InputSection<E> *isec = get_isec(sym))
+        fs.syms[pos[isec->shndx]++] = sym;
+
+    for (i64 i = 0; i < fs.begin.size() - 1; i++)
+      if (fs.begin[i + 1] - fs.begin[i] > 1)
+        std::sort(fs.syms.begin() + fs.begin[i],
+                  fs.syms.begin() + fs.begin[i + 1],
+                  [](Symbol<E> *a, Symbol<E> *b) { return a->value < b->value; });
   });
+}
 
-  if (map.size() <= 1)
-    return map;
+// Appends `val` right-aligned in a `width`-character field. This is
+// equivalent to `std::setw(width) << std::showbase << std::hex` (or
+// std::dec) but is much faster than going through iostreams.
+static void write_num(std::string &buf, u64 val, i64 width, bool hex) {
+  char tmp[24];
+  char *end = tmp + sizeof(tmp);
+  char *p = end;
 
-  tbb::parallel_for(map.range(), [](const typename Map<E>::range_type &range) {
-    for (auto it = range.begin(); it != range.end(); it++) {
-      std::vector<Symbol<E> *> &vec = it->second;
-      sort(vec, [](Symbol<E> *a, Symbol<E> *b) { return a->value < b->value; });
+  if (hex) {
+    u64 x = val;
+    do {
+      *--p = "0123456789abcdef"[x & 15];
+      x >>= 4;
+    } while (x);
+
+    if (val) {
+      *--p = 'x';
+      *--p = '0';
     }
-  });
-  return map;
+  } else {
+    do {
+      *--p = '0' + val % 10;
+      val /= 10;
+    } while (val);
+  }
+
+  if (end - p < width)
+    buf.append(width - (end - p), ' ');
+  buf.append(p, end);
+}
+
+static void write_json_string(std::string &buf, std::string_view str) {
+  buf += '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      buf += '\\';
+      buf += c;
+    } else if ((u8)c < 0x20) {
+      buf += "\\u00";
+      buf += "0123456789abcdef"[(u8)c >> 4];
+      buf += "0123456789abcdef"[c & 15];
+    } else {
+      buf += c;
+    }
+  }
+  buf += '"';
+}
+
+template <typename E>
+static std::string_view get_symbol_name(Context<E> &ctx, Symbol<E> &sym) {
+  if (ctx.arg.demangle)
+    return demangle(sym.name());
+  return sym.name();
+}
+
+template <typename E>
+static void
+write_text_member(Context<E> &ctx, std::string &buf, const SymbolTable<E> &tab,
+                  Chunk<E> *osec, InputSection<E> &mem) {
+  write_num(buf, osec->shdr.sh_addr + mem.offset, 18, true);
+  write_num(buf, mem.sh_size, 11, false);
+  write_num(buf, 1 << mem.p2align, 6, false);
+  buf += "         ";
+  buf += tab.get_file(mem).filename;
+  buf += ":(";
+  buf += mem.name();
+  buf += ")\n";
+
+  for (Symbol<E> *sym : tab.get_symbols(mem)) {
+    write_num(buf, sym->get_addr(ctx), 18, true);
+    buf += "          0     0                 ";
+    buf += get_symbol_name(ctx, *sym);
+    buf += '\n';
+  }
+}
+
+template <typename E>
+static void
+write_json_member(Context<E> &ctx, std::string &buf, const SymbolTable<E> &tab,
+                  Chunk<E> *osec, InputSection<E> &mem) {
+  buf += "{\"file\":";
+  write_json_string(buf, tab.get_file(mem).filename);
+  buf += ",\"name\":";
+  write_json_string(buf, mem.name());
+  buf += ",\"addr\":";
+  write_num(buf, osec->shdr.sh_addr + mem.offset, 0, false);
+  buf += ",\"size\":";
+  write_num(buf, mem.sh_size, 0, false);
+  buf += ",\"align\":";
+  write_num(buf, 1 << mem.p2align, 0, false);
+  buf += ",\"symbols\":[";
+
+  bool first = true;
+  for (Symbol<E> *sym : tab.get_symbols(mem)) {
+    if (!first)
+      buf += ',';
+    first = false;
+    buf += "{\"name\":";
+    write_json_string(buf, sym->name());
+    buf += ",\"addr\":";
+    write_num(buf, sym->get_addr(ctx), 0, false);
+    buf += '}';
+  }
+  buf += "]}";
 }
 
 template <typename E>
@@ -58,55 +196,83 @@ void print_map(Context<E> &ctx) {
   std::unique_ptr<std::ofstream> file;
 
   if (!ctx.arg.Map.empty()) {
-    file = open_output_file(ctx);
+    file.reset(new std::ofstream(ctx.arg.Map.c_str()));
+    if (!file->is_open())
+      Fatal(ctx) << "cannot open " << ctx.arg.Map << ": " << errno_string();
     out = file.get();
   }
 
   // Construct a section-to-symbol map.
-  Map<E> map = get_map(ctx);
+  SymbolTable<E> tab(ctx);
+
+  bool json = ctx.arg.map_json;
+  std::string buf;
+
+  if (json)
+    buf = "{\"output_sections\":[";
+  else
+    buf = "               VMA       Size Align Out     In      Symbol\n";
 
-  // Print a mapfile.
-  *out << "               VMA       Size Align Out     In      Symbol\n";
+  bool first = true;
 
   for (Chunk<E> *osec : ctx.chunks) {
-    *out << std::showbase
-         << std::setw(18) << std::hex << (u64)osec->shdr.sh_addr << std::dec
-         << std::setw(11) << (u64)osec->shdr.sh_size
-         << std::setw(6) << (u64)osec->shdr.sh_addralign
-         << " " << osec->name << "\n";
-
-    if (osec->kind() != OUTPUT_SECTION)
-      continue;
-
-    std::span<InputSection<E> *> members = ((OutputSection<E> *)osec)->members;
-    std::vector<std::string> bufs(members.size());
-
-    tbb::parallel_for((i64)0, (i64)members.size(), [&](i64 i) {
-      InputSection<E> *mem = members[i];
-      std::ostringstream ss;
-      opt_demangle = ctx.arg.demangle;
-      u64 addr = osec->shdr.sh_addr + mem->offset;
-
-      ss << std::showbase
-         << std::setw(18) << std::hex << addr << std::dec
-         << std::setw(11) << (u64)mem->sh_size
-         << std::setw(6) << (1 << (u64)mem->p2align)
-         << "         " << *mem << "\n";
-
-      typename Map<E>::const_accessor acc;
-      if (map.find(acc, mem))
-        for (Symbol<E> *sym : acc->second)
-          ss << std::showbase
-             << std::setw(18) << std::hex << sym->get_addr(ctx) << std::dec
-             << "          0     0                 "
-             << *sym << "\n";
-
-      bufs[i] = ss.str();
-    });
-
-    for (std::string &str : bufs)
-      *out << str;
+    if (json) {
+      if (!first)
+        buf += ",\n";
+      first = false;
+      buf += "{\"name\":";
+      write_json_string(buf, osec->name);
+      buf += ",\"addr\":";
+      write_num(buf, osec->shdr.sh_addr, 0, false);
+      buf += ",\"size\":";
+      write_num(buf, osec->shdr.sh_size, 0, false);
+      buf += ",\"align\":";
+      write_num(buf, osec->shdr.sh_addralign, 0, false);
+      buf += ",\"input_sections\":[";
+    } else {
+      write_num(buf, osec->shdr.sh_addr, 18, true);
+      write_num(buf, osec->shdr.sh_size, 11, false);
+      write_num(buf, osec->shdr.sh_addralign, 6, false);
+      buf += ' ';
+      buf += osec->name;
+      buf += '\n';
+    }
+
+    if (osec->kind() == OUTPUT_SECTION) {
+      // Format members in fixed-size slices so that each thread writes
+      // to its own buffer and the output order stays deterministic.
+      std::span<InputSection<E> *> members = ((OutputSection<E> *)osec)->members;
+      constexpr i64 slice_size = 1024;
+      std::vector<std::string> bufs((members.size() + slice_size - 1) / slice_size);
+
+      tbb::parallel_for((i64)0, (i64)bufs.size(), [&](i64 i) {
+        i64 begin = i * slice_size;
+        i64 end = std::min<i64>(begin + slice_size, members.size());
+
+        for (i64 j = begin; j < end; j++) {
+          if (json) {
+            if (j)
+              bufs[i] += ',';
+            write_json_member(ctx, bufs[i], tab, osec, *members[j]);
+          } else {
+            write_text_member(ctx, bufs[i], tab, osec, *members[j]);
+          }
+        }
+      });
+
+      out->write(buf.data(), buf.size());
+      buf.clear();
+      for (std::string &str : bufs)
+        out->write(str.data(), str.size());
+    }
+
+    if (json)
+      buf += "]}";
   }
+
+  if (json)
+    buf += "]}\n";
+  out->write(buf.data(), buf.size());
 }
 
 using E = MOLD_TARGET;
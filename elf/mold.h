@@ -184,18 +184,22 @@ struct CieRecord {
   }
 
   bool equals(const CieRecord &other) const;
+  u64 get_hash() const;
 
   ObjectFile<E> &file;
   InputSection<E> &input_section;
   u32 input_offset = -1;
   u32 output_offset = -1;
   u32 rel_idx = -1;
-  u32 icf_idx = -1;
+  u32 leader_idx = -1;
   bool is_leader = false;
   std::span<ElfRel<E>> rels;
   std::string_view contents;
 };
 
+template <typename E>
+std::vector<CieRecord<E> *> uniquify_cies(Context<E> &ctx);
+
 template <typename E>
 struct FdeRecord {
   FdeRecord(u32 input_offset, u32 rel_idx)
@@ -212,21 +216,38 @@ struct FdeRecord {
   Atomic<bool> is_alive = true;
 };
 
+// A relocation whose symbol and addend have been resolved in advance.
+// If --relocation-cache is given, we decode relocations of each input
+// section only once so that passes that walk relocations repeatedly
+// (e.g. --gc-sections and ICF) don't have to read ElfRel and the
+// symbol table again. The i'th DecodedRel of a file corresponds to the
+// i'th element of ObjectFile::cached_rels, which is a copy of the raw
+// relocation that InputSection::get_rels returns to the other passes.
+template <typename E>
+struct DecodedRel {
+  Symbol<E> *sym = nullptr;
+  i64 addend = 0;
+  u32 r_offset = 0;
+  u32 r_type = 0;
+};
+
 // A struct to hold target-dependent input section members.
 template <typename E>
 struct InputSectionExtras {};
 
 template <typename E> requires needs_thunk<E>
 struct InputSectionExtras<E> {
-  std::vector<RangeExtensionRef> range_extn;
+  std::span<RangeExtensionRef> range_extn;
 };
 
 template <typename E> requires is_riscv<E>
 struct InputSectionExtras<E> {
-  std::vector<i32> r_deltas;
+  std::span<i32> r_deltas;
 };
 
 // InputSection represents a section in an input object file.
+// InputSections are allocated from Context::arena, so they must be
+// trivially destructible.
 template <typename E>
 class InputSection {
 public:
@@ -259,6 +280,10 @@ public:
 
   std::string_view contents;
 
+  // Pre-decoded relocations for --relocation-cache. This is empty if
+  // the cache is not enabled.
+  std::span<DecodedRel<E>> decoded_rels;
+
   [[no_unique_address]] InputSectionExtras<E> extra;
 
   i32 fde_begin = -1;
@@ -276,9 +301,6 @@ public:
   bool address_significant : 1 = false;
   bool uncompressed : 1 = false;
 
-  // For garbage collection
-  Atomic<bool> is_visited = false;
-
   // For ICF
   //
   // `leader` is the section that this section has been merged with.
@@ -327,6 +349,27 @@ template<typename E> u64 get_dtp_addr(Context<E> &);
 // output-chunks.cc
 //
 
+// The hash function for .hash.
+inline u32 elf_hash(std::string_view name) {
+  u32 h = 0;
+  for (u8 c : name) {
+    h = (h << 4) + c;
+    u32 g = h & 0xf0000000;
+    if (g != 0)
+      h ^= g >> 24;
+    h &= ~g;
+  }
+  return h;
+}
+
+// The hash function for .gnu.hash.
+inline u32 djb_hash(std::string_view name) {
+  u32 h = 5381;
+  for (u8 c : name)
+    h = (h << 5) + h + c;
+  return h;
+}
+
 template <typename E>
 u64 get_eflags(Context<E> &ctx);
 
@@ -630,6 +673,20 @@ public:
   }
 
   void update_shdr(Context<E> &ctx) override;
+  void dedup_strings(Context<E> &ctx);
+  i64 get_name_offset(InputFile<E> &file, i64 idx);
+
+  // For --strtab-dedup
+  struct MapEntry {
+    MapEntry(InputFile<E> *owner) : owner(owner) {}
+    MapEntry(const MapEntry &other)
+      : owner(other.owner.load()), offset(other.offset) {}
+
+    std::atomic<InputFile<E> *> owner;
+    i64 offset = -1;
+  };
+
+  ConcurrentMap<MapEntry> map;
 };
 
 template <typename E>
@@ -922,7 +979,20 @@ public:
   void copy_buf(Context<E> &ctx) override;
   void write_buildid(Context<E> &ctx);
 
+  // For --build-id=fast
+  void start_hashing(Context<E> &ctx);
+  void chunk_copied(Context<E> &ctx, Chunk<E> &chunk);
+
   static constexpr i64 HEADER_SIZE = 16;
+  static constexpr i64 SHARD_SIZE = 4096 * 1024;
+
+private:
+  void hash_shard(Context<E> &ctx, i64 idx);
+
+  std::unordered_map<Chunk<E> *, std::vector<std::pair<i64, i64>>> chunk_ranges;
+  std::vector<std::atomic_int32_t> shard_refcnts;
+  std::vector<std::atomic_bool> is_hashed;
+  std::vector<XXH128_canonical_t> digests;
 };
 
 template <typename E>
@@ -939,6 +1009,35 @@ public:
   void copy_buf(Context<E> &ctx) override;
 };
 
+// .note.binding-cache records which DSO each imported dynamic symbol
+// was resolved to at link-time, so that a prelink-style tool or loader
+// can validate the bindings and apply symbolic relocations in bulk.
+//
+// The note's name is "mold" and its contents is an array of 32-bit
+// words: a version number (1), the number of DSOs, the number of
+// records, the .dynstr offsets of the DSO sonames in DT_NEEDED order,
+// and then 4-word records of {.dynsym index, DSO index, .dynstr offset
+// of the symbol name, .dynstr offset of the version or 0}. Records are
+// sorted by .dynsym index, which is the order in which symbolic
+// relocations appear in .rela.dyn.
+template <typename E>
+class BindingCacheSection : public Chunk<E> {
+public:
+  BindingCacheSection() {
+    this->name = ".note.binding-cache";
+    this->shdr.sh_type = SHT_NOTE;
+    this->shdr.sh_flags = SHF_ALLOC;
+    this->shdr.sh_addralign = 4;
+  }
+
+  void construct(Context<E> &ctx);
+  void update_shdr(Context<E> &ctx) override;
+  void copy_buf(Context<E> &ctx) override;
+
+private:
+  std::vector<Symbol<E> *> symbols;
+};
+
 template <typename E>
 class NotePropertySection : public Chunk<E> {
 public:
@@ -1007,11 +1106,69 @@ private:
   ConcurrentMap<MapEntry> map;
 };
 
+template <typename E>
+struct DebugNamesEntry {
+  std::string_view name;
+  u32 hash = 0;
+  u32 tag = 0;
+  u32 cu_idx = 0;
+  u32 die_offset = 0;
+  SectionFragment<E> *frag = nullptr;
+  u32 entry_idx = 0;
+};
+
+template <typename E>
+class DebugNamesSection : public Chunk<E> {
+public:
+  DebugNamesSection() {
+    this->name = ".debug_names";
+    this->shdr.sh_type = SHT_PROGBITS;
+    this->shdr.sh_addralign = 4;
+  }
+
+  void construct(Context<E> &ctx);
+  void copy_buf(Context<E> &ctx) override;
+  void write_to(Context<E> &ctx, u8 *buf) override;
+
+private:
+  struct MapEntry {
+    MapEntry(u32 hash, SectionFragment<E> *frag) : hash(hash), frag(frag) {}
+
+    MapEntry(const MapEntry &other)
+      : num_entries(other.num_entries.load()),
+        entries_size(other.entries_size.load()),
+        num_assigned(other.num_assigned.load()), hash(other.hash),
+        frag(other.frag), entry_idx(other.entry_idx),
+        entry_offset(other.entry_offset) {}
+
+    std::atomic_uint32_t num_entries = 0;
+    std::atomic_uint32_t entries_size = 0;
+    std::atomic_uint32_t num_assigned = 0;
+    u32 hash = 0;
+    SectionFragment<E> *frag = nullptr;
+    u32 entry_idx = 0;
+    u32 entry_offset = 0;
+  };
+
+  i64 get_abbrev_code(u32 tag);
+
+  ConcurrentMap<MapEntry> map;
+  std::vector<u32> names;
+  std::vector<u32> tags;
+  std::vector<std::vector<i32>> cu_indices;
+  i64 num_compunits = 0;
+  i64 num_buckets = 0;
+  i64 num_entries = 0;
+  i64 abbrev_table_size = 0;
+  i64 entry_pool_size = 0;
+};
+
 template <typename E>
 class CompressedSection : public Chunk<E> {
 public:
   CompressedSection(Context<E> &ctx, Chunk<E> &chunk);
   void copy_buf(Context<E> &ctx) override;
+  void write_to(Context<E> &ctx, u8 *buf) override;
   u8 *get_uncompressed_data() override { return uncompressed.get(); }
 
 private:
@@ -1020,6 +1177,23 @@ private:
   std::unique_ptr<u8[]> uncompressed;
 };
 
+// .gnu_debuglink for --separate-debug-file. It contains the debug
+// file's name and its CRC32. The CRC32 is written after the debug file
+// is complete, so it is zero when the build ID is computed.
+template <typename E>
+class GnuDebuglinkSection : public Chunk<E> {
+public:
+  GnuDebuglinkSection() {
+    this->name = ".gnu_debuglink";
+    this->shdr.sh_type = SHT_PROGBITS;
+    this->shdr.sh_addralign = 4;
+  }
+
+  void update_shdr(Context<E> &ctx) override;
+  void copy_buf(Context<E> &ctx) override;
+  void write_crc32(Context<E> &ctx, u32 crc);
+};
+
 template <typename E>
 class RelocSection : public Chunk<E> {
 public:
@@ -1081,6 +1255,10 @@ std::vector<GdbIndexName> read_pubnames(Context<E> &ctx, ObjectFile<E> &file);
 template <typename E>
 i64 estimate_address_areas(Context<E> &ctx, ObjectFile<E> &file);
 
+template <typename E>
+std::vector<DebugNamesEntry<E>>
+read_debug_names(Context<E> &ctx, ObjectFile<E> &file);
+
 template <typename E>
 std::vector<u64>
 read_address_areas(Context<E> &ctx, ObjectFile<E> &file, i64 offset);
@@ -1115,16 +1293,19 @@ struct ComdatGroupRef {
   std::span<U32<E>> members;
 };
 
+// MergeableSections are allocated from Context::arena along with their
+// arrays, so they must be trivially destructible.
 template <typename E>
 struct MergeableSection {
   std::pair<SectionFragment<E> *, i64> get_fragment(i64 offset);
+  std::string_view get_contents(i64 idx);
 
   MergedSection<E> *parent;
   u8 p2align = 0;
-  std::vector<std::string_view> strings;
-  std::vector<u64> hashes;
-  std::vector<u32> frag_offsets;
-  std::vector<SectionFragment<E> *> fragments;
+  std::string_view contents;
+  std::span<u64> hashes;
+  std::span<u32> frag_offsets;
+  std::span<SectionFragment<E> *> fragments;
 };
 
 // InputFile is the base class of ObjectFile and SharedFile.
@@ -1181,12 +1362,16 @@ public:
   u64 strtab_offset = 0;
   u64 strtab_size = 0;
 
+  // For --strtab-dedup. Indices to StrtabSection's map for symbols
+  // written to .symtab, in the order they are written.
+  std::vector<u32> strtab_entries;
+
   // For --emit-relocs
   std::vector<i32> output_sym_indices;
 
 protected:
-  std::vector<Symbol<E>> local_syms;
-  std::vector<Symbol<E>> frag_syms;
+  std::span<Symbol<E>> local_syms;
+  std::span<Symbol<E>> frag_syms;
 };
 
 // ObjectFile represents an input .o file.
@@ -1215,8 +1400,8 @@ public:
   InputSection<E> *get_section(const ElfSym<E> &esym);
 
   std::string archive_name;
-  std::vector<std::unique_ptr<InputSection<E>>> sections;
-  std::vector<std::unique_ptr<MergeableSection<E>>> mergeable_sections;
+  std::vector<InputSection<E> *> sections;
+  std::vector<MergeableSection<E> *> mergeable_sections;
   bool is_in_lib = false;
   std::vector<ElfShdr<E>> elf_sections2;
   std::vector<CieRecord<E>> cies;
@@ -1235,8 +1420,15 @@ public:
   u64 fde_offset = 0;
   u64 fde_size = 0;
 
+  // For --gc-sections
+  i64 gc_section_idx = 0;
+
+  // For --relocation-cache
+  std::vector<DecodedRel<E>> decoded_rels;
+  std::vector<ElfRel<E>> cached_rels;
+
   // For ICF
-  std::unique_ptr<InputSection<E>> llvm_addrsig;
+  InputSection<E> *llvm_addrsig = nullptr;
 
   // For .gdb_index
   InputSection<E> *debug_info = nullptr;
@@ -1252,6 +1444,11 @@ public:
   i64 names_size = 0;
   i64 names_offset = 0;
   i64 num_areas = 0;
+
+  // For --debug-names
+  InputSection<E> *debug_abbrev = nullptr;
+  InputSection<E> *debug_names = nullptr;
+  std::vector<DebugNamesEntry<E>> debug_names_entries;
   i64 area_offset = 0;
 
   // For PPC32
@@ -1295,7 +1492,13 @@ public:
   void compute_symtab_size(Context<E> &ctx);
   void populate_symtab(Context<E> &ctx);
 
+  // For --lazy-dso-symbols
+  void find_symbols(std::string_view key, std::string_view name,
+                    tbb::concurrent_vector<u32> &vec);
+  void intern_symbols(Context<E> &ctx, std::span<const u32> indices);
+
   bool is_needed = false;
+  bool is_lazy = false;
   std::string soname;
   std::vector<std::string_view> version_strings;
   std::vector<ElfSym<E>> elf_syms2;
@@ -1306,9 +1509,18 @@ private:
   std::string get_soname(Context<E> &ctx);
   void maybe_override_symbol(Symbol<E> &sym, const ElfSym<E> &esym);
   std::vector<std::string_view> read_verdef(Context<E> &ctx);
+  u16 get_versym(i64 idx);
+  void add_symbol(Context<E> &ctx, i64 idx);
 
   std::vector<u16> versyms;
   const ElfShdr<E> *symtab_sec;
+  std::span<ElfSym<E>> dynsyms;
+  std::span<U16<E>> dynvers;
+
+  // For --lazy-dso-symbols
+  std::span<U32<E>> hash_table;
+  bool is_gnu_hash = false;
+  BitVector is_interned;
 
   // Used by find_aliases()
   std::once_flag init_aliases;
@@ -1403,10 +1615,12 @@ std::vector<std::string> parse_nonpositional_args(Context<E> &ctx);
 
 template <typename E> void create_internal_file(Context<E> &);
 template <typename E> void apply_exclude_libs(Context<E> &);
+template <typename E> void intern_dso_symbols(Context<E> &);
 template <typename E> void create_synthetic_sections(Context<E> &);
 template <typename E> void set_file_priority(Context<E> &);
 template <typename E> void resolve_symbols(Context<E> &);
 template <typename E> void kill_eh_frame_sections(Context<E> &);
+template <typename E> void discard_dead_object_debug_info(Context<E> &);
 template <typename E> void resolve_section_pieces(Context<E> &);
 template <typename E> void convert_common_symbols(Context<E> &);
 template <typename E> void compute_merged_section_sizes(Context<E> &);
@@ -1424,6 +1638,8 @@ template <typename E> void compute_section_sizes(Context<E> &);
 template <typename E> void sort_output_sections(Context<E> &);
 template <typename E> void claim_unresolved_symbols(Context<E> &);
 template <typename E> void scan_relocations(Context<E> &);
+template <typename E> void cluster_dynrel_sections(Context<E> &);
+template <typename E> SharedFile<E> *find_glibc_dt_relr_dso(Context<E> &);
 template <typename E> void construct_relr(Context<E> &);
 template <typename E> void create_output_symtab(Context<E> &);
 template <typename E> void report_undef_errors(Context<E> &);
@@ -1433,14 +1649,24 @@ template <typename E> void apply_version_script(Context<E> &);
 template <typename E> void parse_symbol_version(Context<E> &);
 template <typename E> void compute_import_export(Context<E> &);
 template <typename E> void mark_addrsig(Context<E> &);
+template <typename E> void decode_relocations(Context<E> &);
 template <typename E> void clear_padding(Context<E> &);
 template <typename E> void compute_section_headers(Context<E> &);
 template <typename E> i64 set_osec_offsets(Context<E> &);
 template <typename E> void fix_synthetic_symbols(Context<E> &);
 template <typename E> i64 compress_debug_sections(Context<E> &);
+template <typename E> i64 separate_debug_sections(Context<E> &);
+template <typename E> void write_separate_debug_file(Context<E> &);
+template <typename E> void finish_separate_debug_file(Context<E> &);
 template <typename E> void write_dependency_file(Context<E> &);
 template <typename E> void show_stats(Context<E> &);
 
+//
+// arch-x86-64.cc
+//
+
+bool is_ibt_enabled(Context<X86_64> &ctx);
+
 //
 // arch-arm32.cc
 //
@@ -1533,7 +1759,7 @@ private:
 struct BuildId {
   i64 size() const;
 
-  enum { NONE, HEX, HASH, UUID } kind = NONE;
+  enum { NONE, HEX, HASH, UUID, FAST } kind = NONE;
   std::vector<u8> value;
   i64 hash_size = 0;
 };
@@ -1581,6 +1807,11 @@ struct SectionOrder {
 // Target-specific context members
 template <typename E> struct ContextExtras {};
 
+template <> struct ContextExtras<X86_64> {
+  // If true, .plt.got entries are 8 bytes long instead of 16 bytes
+  bool compact_pltgot = false;
+};
+
 template <> struct ContextExtras<PPC32> {
   Symbol<PPC32> *_SDA_BASE_ = nullptr;
 };
@@ -1632,10 +1863,14 @@ struct Context {
     bool Bsymbolic_functions = false;
     bool allow_multiple_definition = false;
     bool apply_dynamic_relocs = true;
+    bool binding_cache = false;
+    bool cluster_dynrels = false;
     bool color_diagnostics = false;
+    bool debug_names = false;
     bool default_symver = false;
     bool demangle = true;
     bool discard_all = false;
+    bool discard_dead_object_debug_info = false;
     bool discard_locals = false;
     bool eh_frame_hdr = true;
     bool emit_relocs = false;
@@ -1652,10 +1887,13 @@ struct Context {
     bool icf_all = false;
     bool ignore_data_address_equality = false;
     bool is_static = false;
+    bool lazy_dso_symbols = false;
     bool lto_pass2 = false;
+    bool map_json = false;
     bool noinhibit_exec = false;
     bool oformat_binary = false;
     bool omagic = false;
+    bool pack_dyn_relocs_auto = false;
     bool pack_dyn_relocs_relr = false;
     bool perf = false;
     bool pic = false;
@@ -1668,6 +1906,7 @@ struct Context {
     bool relax = true;
     bool relocatable = false;
     bool relocatable_merge_sections = false;
+    bool relocation_cache = false;
     bool repro = false;
     bool rosegment = true;
     bool shared = false;
@@ -1675,6 +1914,8 @@ struct Context {
     bool stats = false;
     bool strip_all = false;
     bool strip_debug = false;
+    bool strtab_dedup = false;
+    bool strtab_dedup_suffix = false;
     bool suppress_warnings = false;
     bool trace = false;
     bool undefined_version = false;
@@ -1700,6 +1941,7 @@ struct Context {
     bool z_shstk = false;
     bool z_text = false;
     i64 filler = -1;
+    i64 lto_cache_max_size = 1LL << 30;
     i64 spare_dynamic_tags = 5;
     i64 thread_count = 0;
     std::string_view emulation;
@@ -1714,10 +1956,13 @@ struct Context {
     std::string entry = "_start";
     std::string fini = "_fini";
     std::string init = "_init";
+    std::string lto_cache_dir;
     std::string output = "a.out";
     std::string package_metadata;
+    std::string parse_cache;
     std::string plugin;
     std::string rpaths;
+    std::string separate_debug_file;
     std::string soname;
     std::string sysroot;
     std::unique_ptr<std::unordered_set<std::string_view>> retain_symbols_file;
@@ -1774,6 +2019,10 @@ struct Context {
   tbb::concurrent_vector<std::unique_ptr<Chunk<E>>> chunk_pool;
   tbb::concurrent_vector<std::unique_ptr<OutputSection<E>>> osec_pool;
 
+  // Per-thread bump allocator for input sections, mergeable sections,
+  // their arrays and local symbols
+  Arena arena;
+
   // Symbol auxiliary data
   std::vector<SymbolAux<E>> symbol_aux;
 
@@ -1830,12 +2079,19 @@ struct Context {
   VerdefSection<E> *verdef = nullptr;
   BuildIdSection<E> *buildid = nullptr;
   NotePackageSection<E> *note_package = nullptr;
+  BindingCacheSection<E> *binding_cache = nullptr;
   NotePropertySection<E> *note_property = nullptr;
   GdbIndexSection<E> *gdb_index = nullptr;
+  DebugNamesSection<E> *debug_names = nullptr;
   RelroPaddingSection<E> *relro_padding = nullptr;
+  GnuDebuglinkSection<E> *gnu_debuglink = nullptr;
 
   [[no_unique_address]] ContextExtras<E> extra;
 
+  // For --separate-debug-file
+  std::vector<Chunk<E> *> debug_chunks;
+  std::unique_ptr<OutputFile<Context<E>>> debug_file;
+
   // For --gdb-index
   Chunk<E> *debug_info = nullptr;
   Chunk<E> *debug_abbrev = nullptr;
@@ -2273,6 +2529,13 @@ template <typename E>
 inline std::span<ElfRel<E>> InputSection<E>::get_rels(Context<E> &ctx) const {
   if (relsec_idx == -1)
     return {};
+
+  // If relocations have been cached, return the copy so that we don't
+  // touch pages of the input file again.
+  if (!decoded_rels.empty()) {
+    i64 idx = decoded_rels.data() - file.decoded_rels.data();
+    return {file.cached_rels.data() + idx, decoded_rels.size()};
+  }
   return file.template get_data<ElfRel<E>>(ctx, file.elf_sections[relsec_idx]);
 }
 
@@ -2291,7 +2554,7 @@ InputSection<E>::get_fragment(Context<E> &ctx, const ElfRel<E> &rel) {
 
   const ElfSym<E> &esym = file.elf_syms[rel.r_sym];
   if (esym.st_type == STT_SECTION)
-    if (std::unique_ptr<MergeableSection<E>> &m =
+    if (MergeableSection<E> *m =
         file.mergeable_sections[file.get_shndx(esym)])
       return m->get_fragment(esym.st_value + get_addend(*this, rel));
 
@@ -2363,12 +2626,20 @@ inline bool InputSection<E>::is_killed_by_icf() const {
 template <typename E>
 std::pair<SectionFragment<E> *, i64>
 MergeableSection<E>::get_fragment(i64 offset) {
-  std::vector<u32> &vec = frag_offsets;
+  std::span<u32> vec = frag_offsets;
   auto it = std::upper_bound(vec.begin(), vec.end(), offset);
   i64 idx = it - 1 - vec.begin();
   return {fragments[idx], offset - vec[idx]};
 }
 
+template <typename E>
+std::string_view MergeableSection<E>::get_contents(i64 i) {
+  i64 cur = frag_offsets[i];
+  if (i == frag_offsets.size() - 1)
+    return contents.substr(cur);
+  return contents.substr(cur, frag_offsets[i + 1] - cur);
+}
+
 template <typename E>
 template <typename T>
 inline std::span<T>
@@ -2423,7 +2694,7 @@ inline i64 ObjectFile<E>::get_shndx(const ElfSym<E> &esym) {
 
 template <typename E>
 inline InputSection<E> *ObjectFile<E>::get_section(const ElfSym<E> &esym) {
-  return sections[get_shndx(esym)].get();
+  return sections[get_shndx(esym)];
 }
 
 template <typename E>
@@ -2565,11 +2836,19 @@ inline u64 to_plt_offset(i32 pltidx) {
   }
 }
 
+template <typename E>
+inline i64 get_pltgot_size(Context<E> &ctx) {
+  if constexpr (is_x86_64<E>)
+    if (ctx.extra.compact_pltgot)
+      return 8;
+  return E::pltgot_size;
+}
+
 template <typename E>
 inline u64 Symbol<E>::get_plt_addr(Context<E> &ctx) const {
   if (i32 idx = get_plt_idx(ctx); idx != -1)
     return ctx.plt->shdr.sh_addr + to_plt_offset<E>(idx);
-  return ctx.pltgot->shdr.sh_addr + get_pltgot_idx(ctx) * E::pltgot_size;
+  return ctx.pltgot->shdr.sh_addr + get_pltgot_idx(ctx) * get_pltgot_size(ctx);
 }
 
 template <typename E>
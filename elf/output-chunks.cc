@@ -15,27 +15,6 @@
 
 namespace mold::elf {
 
-// The hash function for .hash.
-static u32 elf_hash(std::string_view name) {
-  u32 h = 0;
-  for (u8 c : name) {
-    h = (h << 4) + c;
-    u32 g = h & 0xf0000000;
-    if (g != 0)
-      h ^= g >> 24;
-    h &= ~g;
-  }
-  return h;
-}
-
-// The hash function for .gnu.hash.
-static u32 djb_hash(std::string_view name) {
-  u32 h = 5381;
-  for (u8 c : name)
-    h = (h << 5) + h + c;
-  return h;
-}
-
 template <typename E>
 u64 get_eflags(Context<E> &ctx) {
   if constexpr (is_arm32<E>)
@@ -528,6 +507,112 @@ void StrtabSection<E>::update_shdr(Context<E> &ctx) {
   this->shdr.sh_size = (offset == 1) ? 0 : offset;
 }
 
+// If --strtab-dedup is given, each unique symbol name is written to
+// .strtab only once. A name is owned by the file with the lowest
+// priority among the files that write it, and only the owner reserves
+// space for it in its own part of .strtab. That keeps the per-file
+// layout of .strtab, so .symtab is still populated in parallel.
+//
+// With --strtab-dedup=suffix, a name that is a suffix of another name
+// owned by the same file shares the longer name's bytes.
+template <typename E>
+void StrtabSection<E>::dedup_strings(Context<E> &ctx) {
+  Timer t(ctx, "dedup_strings");
+
+  std::vector<InputFile<E> *> files;
+  append(files, ctx.objs);
+  append(files, ctx.dsos);
+
+  // Symbols are visited in the same order as populate_symtab().
+  auto for_each_name = [&](InputFile<E> *file, auto fn) {
+    for (i64 i = file->is_dso ? file->first_global : 1;
+         i < file->elf_syms.size(); i++) {
+      Symbol<E> &sym = *file->symbols[i];
+      if (sym.file == file && sym.write_to_symtab)
+        fn(sym.name());
+    }
+  };
+
+  // Estimate the number of unique names.
+  HyperLogLog estimator;
+  tbb::parallel_for_each(files, [&](InputFile<E> *file) {
+    HyperLogLog e;
+    for_each_name(file, [&](std::string_view name) {
+      e.insert(hash_string(name));
+    });
+    estimator.merge(e);
+  });
+
+  // Uniquify names and elect the owner of each name.
+  map.resize(estimator.get_cardinality() * 2);
+
+  tbb::parallel_for_each(files, [&](InputFile<E> *file) {
+    for_each_name(file, [&](std::string_view name) {
+      MapEntry *ent = map.insert(name, hash_string(name), {file}).first;
+
+      InputFile<E> *old_val = ent->owner;
+      while (file->priority < old_val->priority &&
+             !ent->owner.compare_exchange_weak(old_val, file));
+
+      file->strtab_entries.push_back(ent - map.values);
+    });
+  });
+
+  // Assign offsets to owned names within each file.
+  tbb::parallel_for_each(files, [&](InputFile<E> *file) {
+    std::vector<std::pair<std::string_view, MapEntry *>> owned;
+    i64 i = 0;
+
+    for_each_name(file, [&](std::string_view name) {
+      MapEntry &ent = map.values[file->strtab_entries[i++]];
+      if (ent.owner == file && ent.offset == -1) {
+        ent.offset = 0;
+        owned.push_back({name, &ent});
+      }
+    });
+
+    file->strtab_size = 0;
+
+    if (!ctx.arg.strtab_dedup_suffix) {
+      for (std::pair<std::string_view, MapEntry *> &p : owned) {
+        p.second->offset = file->strtab_size;
+        file->strtab_size += p.first.size() + 1;
+      }
+      return;
+    }
+
+    // Sort names in the reverse lexicographical order of their reversed
+    // strings, so that a name comes right after a name it is a suffix of.
+    sort(owned, [](const std::pair<std::string_view, MapEntry *> &a,
+                   const std::pair<std::string_view, MapEntry *> &b) {
+      return std::lexicographical_compare(b.first.rbegin(), b.first.rend(),
+                                          a.first.rbegin(), a.first.rend());
+    });
+
+    std::string_view last;
+    i64 last_offset = 0;
+
+    for (std::pair<std::string_view, MapEntry *> &p : owned) {
+      if (!last.empty() && last.ends_with(p.first)) {
+        p.second->offset = last_offset + last.size() - p.first.size();
+      } else {
+        p.second->offset = file->strtab_size;
+        file->strtab_size += p.first.size() + 1;
+        last = p.first;
+        last_offset = p.second->offset;
+      }
+    }
+  });
+}
+
+// Returns the .strtab offset for the `idx`-th symbol that `file`
+// writes to .symtab. Only valid with --strtab-dedup.
+template <typename E>
+i64 StrtabSection<E>::get_name_offset(InputFile<E> &file, i64 idx) {
+  MapEntry &ent = map.values[file.strtab_entries[idx]];
+  return ent.owner.load()->strtab_offset + ent.offset;
+}
+
 template <typename E>
 void ShstrtabSection<E>::update_shdr(Context<E> &ctx) {
   std::unordered_map<std::string_view, i64> map;
@@ -913,10 +998,14 @@ void OutputSection<E>::write_to(Context<E> &ctx, u8 *buf) {
 // bit. An address must be even and thus its LSB is 0 (odd address is not
 // representable in this encoding and such relocation must be stored to
 // the .rel.dyn section). A bitmap has LSB 1.
-static std::vector<u64> encode_relr(std::span<u64> pos, i64 word_size) {
+template <typename E>
+static std::vector<u64> do_encode_relr(std::span<u64> pos) {
+  constexpr u64 word_size = sizeof(Word<E>);
+  constexpr u64 num_bits = word_size * 8 - 1;
+  constexpr u64 max_delta = num_bits * word_size;
+
   std::vector<u64> vec;
-  u64 num_bits = word_size * 8 - 1;
-  u64 max_delta = num_bits * word_size;
+  vec.reserve(pos.size() / 8 + 1);
 
   for (i64 i = 0; i < pos.size();) {
     assert(i == 0 || pos[i - 1] <= pos[i]);
@@ -941,6 +1030,38 @@ static std::vector<u64> encode_relr(std::span<u64> pos, i64 word_size) {
   return vec;
 }
 
+// A large list of addresses is split into fixed-size shards which are
+// encoded in parallel. Each shard starts a new address group, so the
+// output is deterministic regardless of the number of threads, and it
+// is at most a few words per shard larger than the serial encoding.
+template <typename E>
+static std::vector<u64> encode_relr(std::span<u64> pos) {
+  constexpr i64 shard_size = 1 << 16;
+
+  std::vector<u64> vec;
+  if (pos.size() <= shard_size) {
+    vec = do_encode_relr<E>(pos);
+  } else {
+    std::vector<std::vector<u64>> shards(align_to(pos.size(), shard_size) /
+                                         shard_size);
+
+    tbb::parallel_for((i64)0, (i64)shards.size(), [&](i64 i) {
+      i64 begin = i * shard_size;
+      i64 end = std::min<i64>(begin + shard_size, pos.size());
+      shards[i] = do_encode_relr<E>(pos.subspan(begin, end - begin));
+    });
+    vec = flatten(shards);
+  }
+
+  static Counter relocs("relr_relocs");
+  static Counter words("relr_words");
+  static Counter saved("relr_saved_bytes");
+  relocs += pos.size();
+  words += vec.size();
+  saved += pos.size() * sizeof(ElfRel<E>) - vec.size() * sizeof(Word<E>);
+  return vec;
+}
+
 template <typename E>
 void OutputSection<E>::construct_relr(Context<E> &ctx) {
   if (!ctx.arg.pic)
@@ -972,7 +1093,7 @@ void OutputSection<E>::construct_relr(Context<E> &ctx) {
 
   // Compress them
   std::vector<u64> pos = flatten(shards);
-  relr = encode_relr(pos, sizeof(Word<E>));
+  relr = encode_relr<E>(pos);
 }
 
 // Compute spaces needed for thunk symbols
@@ -1280,7 +1401,7 @@ void GotSection<E>::construct_relr(Context<E> &ctx) {
     if (ent.is_relr(ctx))
       pos.push_back(ent.idx * sizeof(Word<E>));
 
-  relr = encode_relr(pos, sizeof(Word<E>));
+  relr = encode_relr<E>(pos);
 }
 
 template <typename E>
@@ -1451,14 +1572,14 @@ void PltGotSection<E>::add_symbol(Context<E> &ctx, Symbol<E> *sym) {
 
   sym->set_pltgot_idx(ctx, symbols.size());
   symbols.push_back(sym);
-  this->shdr.sh_size = symbols.size() * E::pltgot_size;
+  this->shdr.sh_size = symbols.size() * get_pltgot_size(ctx);
 }
 
 template <typename E>
 void PltGotSection<E>::copy_buf(Context<E> &ctx) {
   u8 *buf = ctx.buf + ctx.pltgot->shdr.sh_offset;
   for (i64 i = 0; i < symbols.size(); i++)
-    write_pltgot_entry(ctx, buf + i * E::pltgot_size, *symbols[i]);
+    write_pltgot_entry(ctx, buf + i * get_pltgot_size(ctx), *symbols[i]);
 }
 
 template <typename E>
@@ -1882,8 +2003,15 @@ MergedSection<E>::insert(Context<E> &ctx, std::string_view data, u64 hash,
 
   // Even if GC is enabled, we garbage-collect only memory-mapped strings.
   // Non-memory-allocated strings are typically identifiers used by debug info.
-  // To remove such strings, use the `strip` command.
-  bool is_alive = !ctx.arg.gc_sections || !(this->shdr.sh_flags & SHF_ALLOC);
+  // To remove such strings, use the `strip` command. An exception is debug
+  // strings under --discard-dead-object-debug-info, which are revived by
+  // discard_dead_object_debug_info() if they are used by remaining files.
+  bool is_alive;
+  if (this->shdr.sh_flags & SHF_ALLOC)
+    is_alive = !ctx.arg.gc_sections;
+  else
+    is_alive = !ctx.arg.discard_dead_object_debug_info ||
+               !this->name.starts_with(".debug");
 
   SectionFragment<E> *frag;
   bool inserted;
@@ -2016,28 +2144,19 @@ void EhFrameSection<E>::construct(Context<E> &ctx) {
   });
 
   // Uniquify CIEs and assign offsets to them.
-  std::vector<CieRecord<E> *> leaders;
-  auto find_leader = [&](CieRecord<E> &cie) -> CieRecord<E> * {
-    for (CieRecord<E> *leader : leaders)
-      if (cie.equals(*leader))
-        return leader;
-    return nullptr;
-  };
+  std::vector<CieRecord<E> *> leaders = uniquify_cies(ctx);
 
   i64 offset = 0;
-  for (ObjectFile<E> *file : ctx.objs) {
-    for (CieRecord<E> &cie : file->cies) {
-      if (CieRecord<E> *leader = find_leader(cie)) {
-        cie.output_offset = leader->output_offset;
-      } else {
-        cie.output_offset = offset;
-        cie.is_leader = true;
-        offset += cie.size();
-        leaders.push_back(&cie);
-      }
-    }
+  for (CieRecord<E> *leader : leaders) {
+    leader->output_offset = offset;
+    offset += leader->size();
   }
 
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    for (CieRecord<E> &cie : file->cies)
+      cie.output_offset = leaders[cie.leader_idx]->output_offset;
+  });
+
   // Assign FDE offsets to files.
   i64 idx = 0;
   for (ObjectFile<E> *file : ctx.objs) {
@@ -2308,7 +2427,11 @@ void VerneedSection<E>::construct(Context<E> &ctx) {
     return !sym->file->is_dso || sym->ver_idx <= VER_NDX_LAST_RESERVED;
   });
 
-  if (syms.empty())
+  // If we are creating .relr.dyn, we need to depend on glibc's
+  // GLIBC_ABI_DT_RELR version, which no symbol refers to.
+  SharedFile<E> *relr_dso = ctx.relrdyn ? find_glibc_dt_relr_dso(ctx) : nullptr;
+
+  if (syms.empty() && !relr_dso)
     return;
 
   sort(syms, [](Symbol<E> *a, Symbol<E> *b) {
@@ -2321,7 +2444,8 @@ void VerneedSection<E>::construct(Context<E> &ctx) {
   ctx.versym->contents[0] = 0;
 
   // Allocate a large enough buffer for .gnu.version_r.
-  contents.resize((sizeof(ElfVerneed<E>) + sizeof(ElfVernaux<E>)) * syms.size());
+  contents.resize((sizeof(ElfVerneed<E>) + sizeof(ElfVernaux<E>)) *
+                  (syms.size() + 1));
 
   // Fill .gnu.version_r.
   u8 *buf = (u8 *)&contents[0];
@@ -2331,6 +2455,19 @@ void VerneedSection<E>::construct(Context<E> &ctx) {
 
   u16 veridx = VER_NDX_LAST_RESERVED + ctx.arg.version_definitions.size();
 
+  auto add_entry = [&](std::string_view verstr) {
+    verneed->vn_cnt++;
+
+    if (aux)
+      aux->vna_next = sizeof(ElfVernaux<E>);
+    aux = (ElfVernaux<E> *)ptr;
+    ptr += sizeof(*aux);
+
+    aux->vna_hash = elf_hash(verstr);
+    aux->vna_other = ++veridx;
+    aux->vna_name = ctx.dynstr->add_string(verstr);
+  };
+
   auto start_group = [&](InputFile<E> *file) {
     this->shdr.sh_info++;
     if (verneed)
@@ -2342,33 +2479,28 @@ void VerneedSection<E>::construct(Context<E> &ctx) {
     verneed->vn_file = ctx.dynstr->find_string(((SharedFile<E> *)file)->soname);
     verneed->vn_aux = sizeof(ElfVerneed<E>);
     aux = nullptr;
-  };
-
-  auto add_entry = [&](Symbol<E> *sym) {
-    verneed->vn_cnt++;
-
-    if (aux)
-      aux->vna_next = sizeof(ElfVernaux<E>);
-    aux = (ElfVernaux<E> *)ptr;
-    ptr += sizeof(*aux);
 
-    std::string_view verstr = sym->get_version();
-    aux->vna_hash = elf_hash(verstr);
-    aux->vna_other = ++veridx;
-    aux->vna_name = ctx.dynstr->add_string(verstr);
+    if (file == relr_dso) {
+      add_entry("GLIBC_ABI_DT_RELR");
+      relr_dso = nullptr;
+    }
   };
 
   for (i64 i = 0; i < syms.size(); i++) {
     if (i == 0 || syms[i - 1]->file != syms[i]->file) {
       start_group(syms[i]->file);
-      add_entry(syms[i]);
+      add_entry(syms[i]->get_version());
     } else if (syms[i - 1]->ver_idx != syms[i]->ver_idx) {
-      add_entry(syms[i]);
+      add_entry(syms[i]->get_version());
     }
 
     ctx.versym->contents[syms[i]->get_dynsym_idx(ctx)] = veridx;
   }
 
+  // No symbol is imported from glibc with a version.
+  if (relr_dso)
+    start_group(relr_dso);
+
   // Resize .gnu.version_r to fit to its contents.
   contents.resize(ptr - buf);
 }
@@ -2453,6 +2585,7 @@ inline i64 BuildId::size() const {
   case HASH:
     return hash_size;
   case UUID:
+  case FAST:
     return 16;
   default:
     unreachable();
@@ -2479,7 +2612,7 @@ static void compute_sha256(Context<E> &ctx, i64 offset) {
   u8 *buf = ctx.buf;
   i64 filesize = ctx.output_file->filesize;
 
-  i64 shard_size = 4096 * 1024;
+  i64 shard_size = BuildIdSection<E>::SHARD_SIZE;
   i64 num_shards = align_to(filesize, shard_size) / shard_size;
   std::vector<u8> shards(num_shards * SHA256_SIZE);
 
@@ -2493,7 +2626,10 @@ static void compute_sha256(Context<E> &ctx, i64 offset) {
     // gets cheaper. We assume that the .note.build-id section is
     // at the beginning of an output file. This is an ugly performance
     // hack, but we can save about 30 ms for a 2 GiB output.
-    if (i > 0 && ctx.output_file->is_mmapped)
+    //
+    // If --separate-debug-file is given, we still need to read the
+    // output file to fill the debug file, so we don't unmap it here.
+    if (i > 0 && ctx.output_file->is_mmapped && !ctx.debug_file)
       munmap(begin, end - begin);
 #endif
    });
@@ -2505,13 +2641,105 @@ static void compute_sha256(Context<E> &ctx, i64 offset) {
   memcpy(buf + offset, digest, ctx.arg.build_id.size());
 
 #ifndef _WIN32
-  if (ctx.output_file->is_mmapped) {
+  if (ctx.output_file->is_mmapped && !ctx.debug_file) {
     munmap(buf, std::min(filesize, shard_size));
     ctx.output_file->is_unmapped = true;
   }
 #endif
 }
 
+// --build-id=fast computes a 128-bit XXH3 hash for each 4 MiB shard of
+// the output file and then a hash of the shard hashes, just like we do
+// for SHA256. XXH3 is not a cryptographic hash but is an order of
+// magnitude faster than SHA256 on processors without SHA instructions.
+//
+// To overlap hashing with copying, copy_chunks() calls chunk_copied()
+// for each chunk, and we hash a shard as soon as all chunks overlapping
+// with it have been written.
+template <typename E>
+void BuildIdSection<E>::start_hashing(Context<E> &ctx) {
+  i64 filesize = ctx.output_file->filesize;
+  i64 num_shards = align_to(filesize, SHARD_SIZE) / SHARD_SIZE;
+
+  shard_refcnts = std::vector<std::atomic_int32_t>(num_shards);
+  is_hashed = std::vector<std::atomic_bool>(num_shards);
+  digests.resize(num_shards);
+
+  // Paddings between chunks are not written by anyone during copying,
+  // so clear them beforehand.
+  clear_padding(ctx);
+
+  // Each chunk covers its contents and the padding after it.
+  std::vector<Chunk<E> *> chunks = ctx.chunks;
+  std::erase_if(chunks, [](Chunk<E> *chunk) {
+    return chunk->shdr.sh_type == SHT_NOBITS;
+  });
+
+  std::unordered_map<Chunk<E> *, std::pair<i64, i64>> ranges;
+  for (i64 i = 0; i < chunks.size(); i++) {
+    i64 begin = chunks[i]->shdr.sh_offset;
+    i64 end = filesize;
+    if (i + 1 < chunks.size())
+      end = chunks[i + 1]->shdr.sh_offset;
+    if (begin < end)
+      ranges[chunks[i]] = {begin, end};
+  }
+
+  // These chunks are modified after copy_chunks(), so shards
+  // containing them are hashed by write_buildid().
+  auto is_late = [&](Chunk<E> *chunk) {
+    if (!E::is_rela && (ctx.arg.emit_relocs || ctx.arg.relocatable))
+      return true;
+    if (is_arm32<E> && chunk->shdr.sh_type == SHT_ARM_EXIDX)
+      return true;
+    return chunk == ctx.gdb_index || chunk == ctx.reldyn;
+  };
+
+  // Register `target`'s range so that its shards are not hashed until
+  // `writer` has been copied.
+  auto add = [&](Chunk<E> *writer, Chunk<E> *target) {
+    auto it = ranges.find(target);
+    if (it == ranges.end())
+      return;
+
+    auto [begin, end] = it->second;
+    for (i64 i = begin / SHARD_SIZE; i < align_to(end, SHARD_SIZE) / SHARD_SIZE; i++)
+      shard_refcnts[i]++;
+
+    if (writer && !is_late(writer))
+      chunk_ranges[writer].push_back({begin, end});
+  };
+
+  for (Chunk<E> *chunk : chunks)
+    add(chunk, chunk);
+
+  // Some chunks write to other chunks.
+  add(ctx.symtab, ctx.strtab);
+  add(ctx.symtab, ctx.symtab_shndx);
+  add(ctx.eh_frame, ctx.eh_frame_hdr);
+}
+
+template <typename E>
+void BuildIdSection<E>::chunk_copied(Context<E> &ctx, Chunk<E> &chunk) {
+  auto it = chunk_ranges.find(&chunk);
+  if (it == chunk_ranges.end())
+    return;
+
+  for (auto [begin, end] : it->second)
+    for (i64 i = begin / SHARD_SIZE; i < align_to(end, SHARD_SIZE) / SHARD_SIZE; i++)
+      if (--shard_refcnts[i] == 0)
+        hash_shard(ctx, i);
+}
+
+template <typename E>
+void BuildIdSection<E>::hash_shard(Context<E> &ctx, i64 idx) {
+  i64 begin = idx * SHARD_SIZE;
+  i64 end = std::min<i64>(begin + SHARD_SIZE, ctx.output_file->filesize);
+  XXH128_hash_t hash = XXH3_128bits(ctx.buf + begin, end - begin);
+  XXH128_canonicalFromHash(&digests[idx], hash);
+  is_hashed[idx] = true;
+}
+
 template <typename E>
 void BuildIdSection<E>::write_buildid(Context<E> &ctx) {
   Timer t(ctx, "build_id");
@@ -2528,6 +2756,18 @@ void BuildIdSection<E>::write_buildid(Context<E> &ctx) {
     // requested.
     compute_sha256(ctx, this->shdr.sh_offset + HEADER_SIZE);
     return;
+  case BuildId::FAST: {
+    tbb::parallel_for((i64)0, (i64)digests.size(), [&](i64 i) {
+      if (!is_hashed[i])
+        hash_shard(ctx, i);
+    });
+
+    XXH128_canonical_t digest;
+    XXH128_canonicalFromHash(&digest, XXH3_128bits(digests.data(),
+                                                   digests.size() * sizeof(digests[0])));
+    memcpy(ctx.buf + this->shdr.sh_offset + HEADER_SIZE, &digest, 16);
+    return;
+  }
   case BuildId::UUID: {
     std::array<u8, 16> uuid = get_uuid_v4();
     memcpy(ctx.buf + this->shdr.sh_offset + HEADER_SIZE, uuid.data(), 16);
@@ -2558,6 +2798,77 @@ void NotePackageSection<E>::copy_buf(Context<E> &ctx) {
   write_string(buf + 4, ctx.arg.package_metadata); // Content
 }
 
+template <typename E>
+void BindingCacheSection<E>::construct(Context<E> &ctx) {
+  Timer t(ctx, "BindingCacheSection::construct");
+  std::span<Symbol<E> *> syms = ctx.dynsym->symbols;
+  if (syms.empty())
+    return;
+
+  std::vector<u8> is_imported(syms.size());
+  tbb::parallel_for((i64)1, (i64)syms.size(), [&](i64 i) {
+    is_imported[i] = syms[i]->file && syms[i]->file->is_dso;
+  });
+
+  symbols.clear();
+  for (i64 i = 1; i < syms.size(); i++)
+    if (is_imported[i])
+      symbols.push_back(syms[i]);
+}
+
+template <typename E>
+void BindingCacheSection<E>::update_shdr(Context<E> &ctx) {
+  // 20 bytes for the note header and "mold\0" padded to 8 bytes
+  i64 num_words = 3 + ctx.dsos.size() + symbols.size() * 4;
+  this->shdr.sh_size = 20 + num_words * 4;
+}
+
+template <typename E>
+void BindingCacheSection<E>::copy_buf(Context<E> &ctx) {
+  U32<E> *buf = (U32<E> *)(ctx.buf + this->shdr.sh_offset);
+  memset(buf, 0, this->shdr.sh_size);
+
+  buf[0] = 5;                          // Name size
+  buf[1] = this->shdr.sh_size - 20;    // Content size
+  buf[2] = NT_MOLD_BINDING_CACHE;      // Type
+  memcpy(buf + 3, "mold", 5);          // Name
+
+  U32<E> *hdr = buf + 5;
+  hdr[0] = 1;
+  hdr[1] = ctx.dsos.size();
+  hdr[2] = symbols.size();
+
+  std::unordered_map<InputFile<E> *, i64> dso_indices;
+  U32<E> *dsos = hdr + 3;
+  for (i64 i = 0; i < ctx.dsos.size(); i++) {
+    dsos[i] = ctx.dynstr->find_string(ctx.dsos[i]->soname);
+    dso_indices[ctx.dsos[i]] = i;
+  }
+
+  // Dynamic symbol names are written to .dynstr in .dynsym order
+  // starting at dynsym_offset. Compute their offsets.
+  std::span<Symbol<E> *> syms = ctx.dynsym->symbols;
+  std::vector<i64> name_offsets(syms.size());
+  i64 offset = ctx.dynstr->dynsym_offset;
+  for (i64 i = 1; i < syms.size(); i++) {
+    name_offsets[i] = offset;
+    offset += syms[i]->name().size() + 1;
+  }
+
+  U32<E> *recs = dsos + ctx.dsos.size();
+  tbb::parallel_for((i64)0, (i64)symbols.size(), [&](i64 i) {
+    Symbol<E> &sym = *symbols[i];
+    i64 idx = sym.get_dynsym_idx(ctx);
+    U32<E> *rec = recs + i * 4;
+
+    rec[0] = idx;
+    rec[1] = dso_indices.find(sym.file)->second;
+    rec[2] = name_offsets[idx];
+    if (sym.ver_idx > VER_NDX_LAST_RESERVED)
+      rec[3] = ctx.dynstr->find_string(sym.get_version());
+  });
+}
+
 // Merges input files' .note.gnu.property values.
 template <typename E>
 void NotePropertySection<E>::update_shdr(Context<E> &ctx) {
@@ -2940,6 +3251,252 @@ void GdbIndexSection<E>::write_address_areas(Context<E> &ctx) {
   });
 }
 
+// This page explains the format of .debug_names:
+// https://dwarfstd.org/doc/DWARF5.pdf (section 6.1.1)
+template <typename E>
+void DebugNamesSection<E>::construct(Context<E> &ctx) {
+  Timer t(ctx, "DebugNamesSection::construct");
+
+  // Assign output CU list indices to compunits. A consumer assumes that
+  // all public names of a listed compunit are in the index, so we list
+  // only compunits that have at least one name. Compunits from object
+  // files without .debug_names or .debug_gnu_pubnames get -1.
+  cu_indices.resize(ctx.objs.size());
+
+  tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
+    ObjectFile<E> &file = *ctx.objs[i];
+    cu_indices[i].resize(file.compunits.size(), -1);
+    for (DebugNamesEntry<E> &ent : file.debug_names_entries)
+      cu_indices[i][ent.cu_idx] = 0;
+  });
+
+  for (std::vector<i32> &vec : cu_indices)
+    for (i32 &idx : vec)
+      if (idx != -1)
+        idx = num_compunits++;
+
+  if (num_compunits == 0)
+    return;
+
+  // Collect DW_TAG_* values. Each tag gets its own abbreviation code.
+  std::vector<std::vector<u32>> file_tags(ctx.objs.size());
+
+  tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
+    std::vector<u32> &vec = file_tags[i];
+    for (DebugNamesEntry<E> &ent : ctx.objs[i]->debug_names_entries)
+      vec.push_back(ent.tag);
+    sort(vec);
+    remove_duplicates(vec);
+  });
+
+  for (std::vector<u32> &vec : file_tags)
+    append(tags, vec);
+  sort(tags);
+  remove_duplicates(tags);
+
+  // Estimate the unique number of names.
+  HyperLogLog estimator;
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    HyperLogLog e;
+    for (DebugNamesEntry<E> &ent : file->debug_names_entries)
+      e.insert(hash_string(ent.name));
+    estimator.merge(e);
+  });
+
+  // Uniquify names by inserting them into a concurrent hashmap.
+  map.resize(estimator.get_cardinality() * 2);
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    for (DebugNamesEntry<E> &ent : file->debug_names_entries) {
+      MapEntry *me = map.insert(ent.name, hash_string(ent.name),
+                                {ent.hash, ent.frag}).first;
+      me->num_entries++;
+      me->entries_size += uleb_size(get_abbrev_code(ent.tag)) + 8;
+      ent.entry_idx = me - map.values;
+    }
+  });
+
+  // Names are sorted by bucket index. We use the same number of buckets
+  // as LLVM does.
+  const i64 shard_size = map.nbuckets / map.NUM_SHARDS;
+  std::vector<std::vector<u32>> shards(map.NUM_SHARDS);
+
+  tbb::parallel_for((i64)0, (i64)map.NUM_SHARDS, [&](i64 i) {
+    for (i64 j = shard_size * i; j < shard_size * (i + 1); j++)
+      if (map.get_key(j))
+        shards[i].push_back(j);
+  });
+
+  for (std::vector<u32> &vec : shards)
+    append(names, vec);
+
+  if (names.empty())
+    return;
+
+  if (names.size() > 1024)
+    num_buckets = names.size() / 4;
+  else if (names.size() > 16)
+    num_buckets = names.size() / 2;
+  else
+    num_buckets = names.size();
+
+  auto get_name = [&](u32 idx) {
+    return std::string_view(map.get_key(idx), map.key_sizes[idx]);
+  };
+
+  tbb::parallel_sort(names.begin(), names.end(), [&](u32 a, u32 b) {
+    return std::tuple(map.values[a].hash % num_buckets, get_name(a)) <
+           std::tuple(map.values[b].hash % num_buckets, get_name(b));
+  });
+
+  // Assign entry indices and entry pool offsets to names.
+  for (u32 idx : names) {
+    MapEntry &me = map.values[idx];
+    me.entry_idx = num_entries;
+    me.entry_offset = entry_pool_size;
+    num_entries += me.num_entries;
+    entry_pool_size += me.entries_size + 1;
+  }
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    for (DebugNamesEntry<E> &ent : file->debug_names_entries) {
+      MapEntry &me = map.values[ent.entry_idx];
+      ent.entry_idx = me.entry_idx + me.num_assigned++;
+    }
+  });
+
+  // Each abbreviation is a code, a tag, DW_IDX_compile_unit and
+  // DW_IDX_die_offset attributes and a null terminator.
+  for (i64 i = 0; i < tags.size(); i++)
+    abbrev_table_size += uleb_size(i + 1) + uleb_size(tags[i]) + 6;
+  abbrev_table_size++;
+
+  this->shdr.sh_size = 36 + num_compunits * 4 + num_buckets * 4 +
+                       names.size() * 12 + abbrev_table_size +
+                       entry_pool_size;
+}
+
+template <typename E>
+i64 DebugNamesSection<E>::get_abbrev_code(u32 tag) {
+  return std::lower_bound(tags.begin(), tags.end(), tag) - tags.begin() + 1;
+}
+
+template <typename E>
+void DebugNamesSection<E>::copy_buf(Context<E> &ctx) {
+  write_to(ctx, ctx.buf + this->shdr.sh_offset);
+}
+
+template <typename E>
+void DebugNamesSection<E>::write_to(Context<E> &ctx, u8 *buf) {
+  Timer t(ctx, "DebugNamesSection::write_to");
+
+  // Write the header.
+  struct DebugNamesHeader {
+    U32<E> unit_length;
+    U16<E> version;
+    U16<E> padding;
+    U32<E> comp_unit_count;
+    U32<E> local_type_unit_count;
+    U32<E> foreign_type_unit_count;
+    U32<E> bucket_count;
+    U32<E> name_count;
+    U32<E> abbrev_table_size;
+    U32<E> augmentation_string_size;
+  };
+
+  DebugNamesHeader &hdr = *(DebugNamesHeader *)buf;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.unit_length = this->shdr.sh_size - 4;
+  hdr.version = 5;
+  hdr.comp_unit_count = num_compunits;
+  hdr.bucket_count = num_buckets;
+  hdr.name_count = names.size();
+  hdr.abbrev_table_size = abbrev_table_size;
+
+  // Write the compunit list.
+  U32<E> *cu_list = (U32<E> *)(buf + sizeof(hdr));
+  for (i64 i = 0; i < ctx.objs.size(); i++) {
+    ObjectFile<E> &file = *ctx.objs[i];
+    if (!file.debug_info)
+      continue;
+
+    u64 offset = file.debug_info->offset;
+    for (i64 j = 0; j < file.compunits.size(); j++) {
+      if (cu_indices[i][j] != -1)
+        *cu_list++ = offset;
+      offset += file.compunits[j].size();
+    }
+  }
+
+  // Write the hash table.
+  U32<E> *buckets = cu_list;
+  U32<E> *hashes = buckets + num_buckets;
+  U32<E> *str_offsets = hashes + names.size();
+  U32<E> *entry_offsets = str_offsets + names.size();
+
+  memset(buckets, 0, num_buckets * 4);
+
+  for (i64 i = 0; i < names.size(); i++) {
+    MapEntry &me = map.values[names[i]];
+    U32<E> &bucket = buckets[me.hash % num_buckets];
+    if (bucket == 0)
+      bucket = i + 1;
+    hashes[i] = me.hash;
+    str_offsets[i] = me.frag->offset;
+    entry_offsets[i] = me.entry_offset;
+  }
+
+  // Write the abbreviation table.
+  u8 *p = (u8 *)(entry_offsets + names.size());
+  for (i64 i = 0; i < tags.size(); i++) {
+    p += write_uleb(p, i + 1);
+    p += write_uleb(p, tags[i]);
+    *p++ = DW_IDX_compile_unit;
+    *p++ = DW_FORM_data4;
+    *p++ = DW_IDX_die_offset;
+    *p++ = DW_FORM_ref4;
+    *p++ = 0;
+    *p++ = 0;
+  }
+  *p++ = 0;
+
+  // Write the entry pool. Entries are sorted for build reproducibility.
+  struct Entry {
+    u32 code;
+    u32 cu_idx;
+    u32 die_offset;
+  };
+
+  std::vector<Entry> entries(num_entries);
+
+  tbb::parallel_for((i64)0, (i64)ctx.objs.size(), [&](i64 i) {
+    for (DebugNamesEntry<E> &ent : ctx.objs[i]->debug_names_entries)
+      entries[ent.entry_idx] = {(u32)get_abbrev_code(ent.tag),
+                                (u32)cu_indices[i][ent.cu_idx],
+                                ent.die_offset};
+  });
+
+  tbb::parallel_for((i64)0, (i64)names.size(), [&](i64 i) {
+    MapEntry &me = map.values[names[i]];
+    Entry *begin = entries.data() + me.entry_idx;
+    Entry *end = begin + me.num_entries;
+
+    std::sort(begin, end, [](const Entry &a, const Entry &b) {
+      return std::tuple(a.cu_idx, a.die_offset, a.code) <
+             std::tuple(b.cu_idx, b.die_offset, b.code);
+    });
+
+    u8 *q = p + me.entry_offset;
+    for (Entry *e = begin; e < end; e++) {
+      q += write_uleb(q, e->code);
+      *(U32<E> *)q = e->cu_idx;
+      *(U32<E> *)(q + 4) = e->die_offset;
+      q += 8;
+    }
+    *q = 0;
+  });
+}
+
 template <typename E>
 CompressedSection<E>::CompressedSection(Context<E> &ctx, Chunk<E> &chunk) {
   assert(chunk.name.starts_with(".debug"));
@@ -2977,9 +3534,34 @@ CompressedSection<E>::CompressedSection(Context<E> &ctx, Chunk<E> &chunk) {
 
 template <typename E>
 void CompressedSection<E>::copy_buf(Context<E> &ctx) {
-  u8 *base = ctx.buf + this->shdr.sh_offset;
-  memcpy(base, &chdr, sizeof(chdr));
-  compressed->write_to(base + sizeof(chdr));
+  write_to(ctx, ctx.buf + this->shdr.sh_offset);
+}
+
+template <typename E>
+void CompressedSection<E>::write_to(Context<E> &ctx, u8 *buf) {
+  memcpy(buf, &chdr, sizeof(chdr));
+  compressed->write_to(buf + sizeof(chdr));
+}
+
+template <typename E>
+void GnuDebuglinkSection<E>::update_shdr(Context<E> &ctx) {
+  std::string name = filepath(ctx.arg.separate_debug_file).filename().string();
+  this->shdr.sh_size = align_to(name.size() + 1, 4) + 4;
+}
+
+template <typename E>
+void GnuDebuglinkSection<E>::copy_buf(Context<E> &ctx) {
+  u8 *buf = ctx.buf + this->shdr.sh_offset;
+  memset(buf, 0, this->shdr.sh_size);
+
+  std::string name = filepath(ctx.arg.separate_debug_file).filename().string();
+  write_string(buf, name);
+}
+
+template <typename E>
+void GnuDebuglinkSection<E>::write_crc32(Context<E> &ctx, u32 crc) {
+  u8 *buf = ctx.buf + this->shdr.sh_offset;
+  *(U32<E> *)(buf + this->shdr.sh_size - 4) = crc;
 }
 
 template <typename E>
@@ -3125,9 +3707,12 @@ template class VerneedSection<E>;
 template class VerdefSection<E>;
 template class BuildIdSection<E>;
 template class NotePackageSection<E>;
+template class BindingCacheSection<E>;
 template class NotePropertySection<E>;
 template class GdbIndexSection<E>;
+template class DebugNamesSection<E>;
 template class CompressedSection<E>;
+template class GnuDebuglinkSection<E>;
 template class RelocSection<E>;
 template class ComdatGroupSection<E>;
 template i64 to_phdr_flags(Context<E> &ctx, Chunk<E> *chunk);
@@ -11,6 +11,7 @@
 #include <tbb/parallel_sort.h>
 #include <tbb/partitioner.h>
 #include <unordered_set>
+#include <zlib.h>
 
 namespace mold::elf {
 
@@ -93,6 +94,8 @@ void create_synthetic_sections(Context<E> &ctx) {
     ctx.eh_frame_hdr = push(new EhFrameHdrSection<E>);
   if (ctx.arg.gdb_index)
     ctx.gdb_index = push(new GdbIndexSection<E>);
+  if (ctx.arg.debug_names)
+    ctx.debug_names = push(new DebugNamesSection<E>);
   if (ctx.arg.z_relro && ctx.arg.section_order.empty() &&
       ctx.arg.z_separate_code != SEPARATE_LOADABLE_SEGMENTS)
     ctx.relro_padding = push(new RelroPaddingSection<E>);
@@ -111,6 +114,8 @@ void create_synthetic_sections(Context<E> &ctx) {
   ctx.versym = push(new VersymSection<E>);
   ctx.verneed = push(new VerneedSection<E>);
   ctx.note_package = push(new NotePackageSection<E>);
+  if (ctx.arg.binding_cache)
+    ctx.binding_cache = push(new BindingCacheSection<E>);
   ctx.note_property = push(new NotePropertySection<E>);
 
 
@@ -134,6 +139,45 @@ void create_synthetic_sections(Context<E> &ctx) {
   }
 }
 
+// If --lazy-dso-symbols is given, defined symbols of shared objects are
+// not interned to the global symbol table when shared objects are read.
+// Instead, we look up names that are known at this point (i.e. names
+// referenced or defined by object files, DSOs' undefined symbols and
+// names given by command line options) in each DSO's hash table and
+// intern only found symbols. This makes the number of Symbol objects
+// proportional to the program size and not to the size of libraries.
+template <typename E>
+void intern_dso_symbols(Context<E> &ctx) {
+  Timer t(ctx, "intern_dso_symbols");
+
+  std::vector<SharedFile<E> *> dsos;
+  for (SharedFile<E> *file : ctx.dsos)
+    if (file->is_lazy)
+      dsos.push_back(file);
+
+  if (dsos.empty())
+    return;
+
+  for (std::string_view name : ctx.arg.undefined)
+    get_symbol(ctx, name);
+  for (std::string_view name : ctx.arg.require_defined)
+    get_symbol(ctx, name);
+
+  std::vector<tbb::concurrent_vector<u32>> vec(dsos.size());
+
+  tbb::parallel_for(ctx.symbol_map.range(), [&](auto &range) {
+    for (auto it = range.begin(); it != range.end(); it++)
+      for (i64 i = 0; i < dsos.size(); i++)
+        dsos[i]->find_symbols(it->first, it->second.name(), vec[i]);
+  });
+
+  tbb::parallel_for((i64)0, (i64)dsos.size(), [&](i64 i) {
+    std::vector<u32> indices(vec[i].begin(), vec[i].end());
+    sort(indices);
+    dsos[i]->intern_symbols(ctx, indices);
+  });
+}
+
 template <typename E>
 static void mark_live_objects(Context<E> &ctx) {
   auto mark_symbol = [&](std::string_view name) {
@@ -271,6 +315,11 @@ void resolve_symbols(Context<E> &ctx) {
 
     append(ctx.objs, lto_objs);
 
+    // The ELF files returned from do_lto() may refer to symbols that
+    // were not referenced by IR files (e.g. memcpy).
+    if (ctx.arg.lazy_dso_symbols)
+      intern_dso_symbols(ctx);
+
     // Redo name resolution from scratch.
     tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
       file->clear_symbols();
@@ -305,7 +354,7 @@ void kill_eh_frame_sections(Context<E> &ctx) {
 
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
     for (i64 i = 0; i < file->sections.size(); i++) {
-      if (std::unique_ptr<InputSection<E>> &isec = file->sections[i]) {
+      if (InputSection<E> *isec = file->sections[i]) {
         if (isec && isec->is_alive && isec->name() == ".eh_frame") {
           isec->is_alive = false;
         }
@@ -314,16 +363,128 @@ void kill_eh_frame_sections(Context<E> &ctx) {
   });
 }
 
+// If all code and data of an object file have been discarded by
+// --gc-sections, --icf or COMDAT deduplication, its debug info only
+// describes things that don't exist in the output. This function removes
+// debug sections of such files if --discard-dead-object-debug-info is
+// given. This works at file granularity; we don't rewrite debug info of
+// files that are still partially alive.
+//
+// We consider a file's debug info dead if its debug sections refer to at
+// least one allocated section of the same file and all such sections are
+// dead. Debug info that doesn't refer to any allocated section (e.g. a
+// compunit containing only type definitions) is kept as-is.
+//
+// Strings in mergeable debug sections such as .debug_str are created dead
+// under this option. We revive the ones used by the remaining files here
+// so that strings only used by removed debug info don't occupy space.
+template <typename E>
+void discard_dead_object_debug_info(Context<E> &ctx) {
+  Timer t(ctx, "discard_dead_object_debug_info");
+
+  auto is_debug_section = [](InputSection<E> *isec) {
+    return isec && isec->is_alive && !(isec->shdr().sh_flags & SHF_ALLOC) &&
+           isec->name().starts_with(".debug");
+  };
+
+  auto is_dead = [&](ObjectFile<E> &file) {
+    bool has_refs = false;
+
+    for (InputSection<E> *isec : file.sections) {
+      if (!is_debug_section(isec))
+        continue;
+
+      for (const ElfRel<E> &rel : isec->get_rels(ctx)) {
+        Symbol<E> &sym = *file.symbols[rel.r_sym];
+        if (sym.file != &file)
+          continue;
+
+        InputSection<E> *target = sym.get_input_section();
+        if (!target || !(target->shdr().sh_flags & SHF_ALLOC))
+          continue;
+        if (target->is_alive)
+          return false;
+        has_refs = true;
+      }
+    }
+    return has_refs;
+  };
+
+  static Counter counter("dead_debug_info_files");
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    if (!is_dead(*file)) {
+      for (MergeableSection<E> *m : file->mergeable_sections)
+        if (m && m->parent->name.starts_with(".debug"))
+          for (SectionFragment<E> *frag : m->fragments)
+            frag->is_alive = true;
+
+      for (DebugNamesEntry<E> &ent : file->debug_names_entries)
+        ent.frag->is_alive = true;
+      return;
+    }
+
+    for (InputSection<E> *isec : file->sections)
+      if (is_debug_section(isec))
+        isec->is_alive = false;
+
+    // Forget the debug sections for --gdb-index and --debug-names.
+    file->debug_info = nullptr;
+    file->debug_ranges = nullptr;
+    file->debug_rnglists = nullptr;
+    file->debug_pubnames = nullptr;
+    file->debug_pubtypes = nullptr;
+    file->compunits.clear();
+    file->debug_names_entries.clear();
+    counter++;
+  });
+}
+
 template <typename E>
 void resolve_section_pieces(Context<E> &ctx) {
   Timer t(ctx, "resolve_section_pieces");
 
+  if (!ctx.arg.parse_cache.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(ctx.arg.parse_cache, ec);
+    if (ec)
+      Fatal(ctx) << "cannot create parse cache directory "
+                 << ctx.arg.parse_cache << ": " << ec.message();
+  }
+
+  // Names in .debug_names refer to strings in .debug_str. We read them
+  // here because they may add new strings to .debug_str.
+  MergedSection<E> *debug_str = nullptr;
+  if (ctx.arg.debug_names)
+    debug_str = MergedSection<E>::get_instance(ctx, ".debug_str", SHT_PROGBITS,
+                                               SHF_MERGE | SHF_STRINGS);
+
+  auto get_key = [](std::string_view name) {
+    return std::string_view(name.data(), name.size() + 1);
+  };
+
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
     file->initialize_mergeable_sections(ctx);
+
+    if (debug_str) {
+      file->debug_names_entries = read_debug_names(ctx, *file);
+
+      HyperLogLog estimator;
+      for (DebugNamesEntry<E> &ent : file->debug_names_entries)
+        estimator.insert(hash_string(get_key(ent.name)));
+      debug_str->estimator.merge(estimator);
+    }
   });
 
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
     file->resolve_section_pieces(ctx);
+
+    if (debug_str) {
+      for (DebugNamesEntry<E> &ent : file->debug_names_entries) {
+        std::string_view key = get_key(ent.name);
+        ent.frag = debug_str->insert(ctx, key, hash_string(key), 0);
+      }
+    }
   });
 }
 
@@ -511,7 +672,7 @@ void create_output_sections(Context<E> &ctx) {
       cache = map;
     }
 
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
+    for (InputSection<E> *isec : file->sections) {
       if (!isec || !isec->is_alive)
         continue;
 
@@ -550,9 +711,9 @@ void create_output_sections(Context<E> &ctx) {
 
   // Add input sections to output sections
   for (ObjectFile<E> *file : ctx.objs)
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections)
+    for (InputSection<E> *isec : file->sections)
       if (isec && isec->is_alive)
-        isec->output_section->members.push_back(isec.get());
+        isec->output_section->members.push_back(isec);
 
   // Add output sections and mergeable sections to ctx.chunks
   std::vector<Chunk<E> *> vec;
@@ -854,7 +1015,7 @@ R"(# This is an output of the mold linker's --print-dependencies option.
   };
 
   for (ObjectFile<E> *file : ctx.objs) {
-    for (std::unique_ptr<InputSection<E>> &isec : file->sections) {
+    for (InputSection<E> *isec : file->sections) {
       if (!isec)
         continue;
 
@@ -1137,6 +1298,57 @@ void shuffle_sections(Context<E> &ctx) {
   }
 }
 
+// The dynamic loader writes to every word that has a dynamic
+// relocation, so each page containing at least one such word becomes a
+// private copy-on-write page. This pass sorts members of .data.rel.ro
+// and .data by relocation density so that relocated words are packed
+// into as few pages as possible.
+template <typename E>
+void cluster_dynrel_sections(Context<E> &ctx) {
+  Timer t(ctx, "cluster_dynrel_sections");
+
+  // Returns the number of relocations in a given section that will
+  // be turned into dynamic relocations (including RELR ones).
+  auto count_dynrels = [&](InputSection<E> &isec) {
+    i64 n = 0;
+    for (const ElfRel<E> &rel : isec.get_rels(ctx)) {
+      if (rel.r_type != E::R_ABS)
+        continue;
+      Symbol<E> &sym = *isec.file.symbols[rel.r_sym];
+      if (ctx.arg.pic || sym.is_imported || sym.is_ifunc())
+        n++;
+    }
+    return n;
+  };
+
+  struct Entry {
+    InputSection<E> *isec;
+    i64 num_dynrels;
+    i64 size;
+  };
+
+  tbb::parallel_for_each(ctx.chunks, [&](Chunk<E> *chunk) {
+    OutputSection<E> *osec = chunk->to_osec();
+    if (!osec || (osec->name != ".data.rel.ro" && osec->name != ".data"))
+      return;
+
+    std::vector<Entry> vec(osec->members.size());
+    tbb::parallel_for((i64)0, (i64)vec.size(), [&](i64 i) {
+      InputSection<E> *isec = osec->members[i];
+      vec[i] = {isec, count_dynrels(*isec), std::max<i64>(isec->sh_size, 1)};
+    });
+
+    // Compare a.num_dynrels / a.size with b.num_dynrels / b.size
+    // without using floating-point numbers.
+    std::stable_sort(vec.begin(), vec.end(), [](const Entry &a, const Entry &b) {
+      return a.num_dynrels * b.size > b.num_dynrels * a.size;
+    });
+
+    for (i64 i = 0; i < vec.size(); i++)
+      osec->members[i] = vec[i].isec;
+  });
+}
+
 template <typename E>
 void compute_section_sizes(Context<E> &ctx) {
   Timer t(ctx, "compute_section_sizes");
@@ -1349,6 +1561,13 @@ void scan_relocations(Context<E> &ctx) {
   for (Symbol<E> *sym : syms) {
     sym->add_aux(ctx);
 
+    // Lazy binding is disabled by `-z now`, so on x86-64, we use
+    // .plt.got instead of .plt, as the former doesn't need a PLT header
+    // and its entries can be shorter.
+    if constexpr (is_x86_64<E>)
+      if (ctx.arg.z_now && (sym->flags & NEEDS_PLT) && !(sym->flags & NEEDS_CPLT))
+        sym->flags |= NEEDS_GOT;
+
     if (sym->is_imported || sym->is_exported)
       ctx.dynsym->add_symbol(ctx, sym);
 
@@ -1456,12 +1675,31 @@ template <typename E>
 void copy_chunks(Context<E> &ctx) {
   Timer t(ctx, "copy_chunks");
 
+  // With --build-id=fast, shards of the output file are hashed as soon
+  // as they are written.
+  BuildIdSection<E> *buildid = nullptr;
+  if (ctx.buildid && ctx.arg.build_id.kind == BuildId::FAST) {
+    buildid = ctx.buildid;
+    buildid->start_hashing(ctx);
+  }
+
   auto copy = [&](Chunk<E> &chunk) {
-    std::string name = chunk.name.empty() ? "(header)" : std::string(chunk.name);
-    Timer t2(ctx, name, &t);
-    chunk.copy_buf(ctx);
+    {
+      std::string name = chunk.name.empty() ? "(header)" : std::string(chunk.name);
+      Timer t2(ctx, name, &t);
+      chunk.copy_buf(ctx);
+    }
+
+    if (buildid)
+      buildid->chunk_copied(ctx, chunk);
   };
 
+  // With --separate-debug-file, debug sections are written to another
+  // file in parallel with the main output.
+  tbb::task_group tg;
+  if (!ctx.arg.separate_debug_file.empty())
+    tg.run([&] { write_separate_debug_file(ctx); });
+
   // For --relocatable and --emit-relocs, we want to copy non-relocation
   // sections first. This is because REL-type relocation sections (as
   // opposed to RELA-type) stores relocation addends to target sections.
@@ -1475,6 +1713,8 @@ void copy_chunks(Context<E> &ctx) {
       copy(*chunk);
   });
 
+  tg.wait();
+
   // Undefined symbols in SHF_ALLOC sections are found by scan_relocations(),
   // but those in non-SHF_ALLOC sections cannot be found until we copy section
   // contents. So we need to call this function again to report possible
@@ -1485,6 +1725,18 @@ void copy_chunks(Context<E> &ctx) {
     fixup_arm_exidx_section(ctx);
 }
 
+// glibc 2.36 or later defines GLIBC_ABI_DT_RELR version in libc.so.
+// It refuses to load an object file that has DT_RELR unless the file
+// depends on the version.
+template <typename E>
+SharedFile<E> *find_glibc_dt_relr_dso(Context<E> &ctx) {
+  for (SharedFile<E> *file : ctx.dsos)
+    for (std::string_view ver : file->version_strings)
+      if (ver == "GLIBC_ABI_DT_RELR")
+        return file;
+  return nullptr;
+}
+
 template <typename E>
 void construct_relr(Context<E> &ctx) {
   Timer t(ctx, "construct_relr");
@@ -1512,6 +1764,45 @@ void create_output_symtab(Context<E> &ctx) {
   tbb::parallel_for_each(ctx.dsos, [&](SharedFile<E> *file) {
     file->compute_symtab_size(ctx);
   });
+
+  if (ctx.arg.strtab_dedup && ctx.strtab)
+    ctx.strtab->dedup_strings(ctx);
+}
+
+// Demangling is expensive, so when matching symbols against
+// `extern "C++"` version patterns, we want to skip symbols that cannot
+// possibly match. A pattern such as `foo::bar*` can match only a
+// symbol whose demangled name starts with `foo`, and since the first
+// occurrence of an identifier is always spelled out in a mangled name,
+// such symbol's mangled name must contain `foo` as a substring.
+//
+// That's not true for identifiers that are not spelled out in mangled
+// names, such as `std` (which is abbreviated as `St`), builtin type
+// names or special names like `vtable for`. This function returns an
+// empty string if we cannot compute a prefilter for a given pattern.
+static std::string_view get_cpp_prefilter(std::string_view pat) {
+  static const char *unsafe[] = {
+    "std", "operator", "decltype", "auto", "void", "bool", "char",
+    "wchar_t", "char8_t", "char16_t", "char32_t", "short", "int", "long",
+    "signed", "unsigned", "float", "double", "half", "decimal32",
+    "decimal64", "decimal128", "const", "volatile",
+    "vtable", "VTT", "typeinfo", "construction", "guard", "reference",
+    "non", "virtual", "covariant", "transaction", "TLS", "hidden",
+    "java", "initializer",
+  };
+
+  i64 len = 0;
+  while (len < pat.size() && (isalnum(pat[len]) || pat[len] == '_'))
+    len++;
+
+  std::string_view ident = pat.substr(0, len);
+  if (ident.empty() || isdigit(ident[0]) || ident[0] == '_')
+    return "";
+
+  for (std::string_view word : unsafe)
+    if (word.starts_with(ident))
+      return "";
+  return ident;
 }
 
 template <typename E>
@@ -1545,18 +1836,32 @@ void apply_version_script(Context<E> &ctx) {
   // Otherwise, use glob pattern matchers.
   MultiGlob matcher;
   MultiGlob cpp_matcher;
+  MultiGlob cpp_prefilter;
+  bool use_cpp_prefilter = true;
 
   for (i64 i = 0; i < ctx.version_patterns.size(); i++) {
     VersionPattern &v = ctx.version_patterns[i];
     if (v.is_cpp) {
       if (!cpp_matcher.add(v.pattern, i))
         Fatal(ctx) << "invalid version pattern: " << v.pattern;
+
+      std::string_view ident = get_cpp_prefilter(v.pattern);
+      if (ident.empty()) {
+        use_cpp_prefilter = false;
+      } else {
+        std::string glob = "*";
+        glob += ident;
+        glob += "*";
+        cpp_prefilter.add(glob, 0);
+      }
     } else {
       if (!matcher.add(v.pattern, i))
         Fatal(ctx) << "invalid version pattern: " << v.pattern;
     }
   }
 
+  static Counter cpp_prefilter_skipped("cpp_prefilter_skipped");
+
   tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
     for (Symbol<E> *sym : file->get_global_syms()) {
       if (sym->file != file)
@@ -1571,10 +1876,15 @@ void apply_version_script(Context<E> &ctx) {
       // Match non-mangled symbols against the C++ pattern as well.
       // Weird, but required to match other linkers' behavior.
       if (!cpp_matcher.empty()) {
-        if (std::optional<std::string_view> s = cpp_demangle(name))
-          name = *s;
-        if (std::optional<u32> idx = cpp_matcher.find(name))
-          match = std::min<i64>(match, *idx);
+        if (name.starts_with("_Z") && use_cpp_prefilter &&
+            !cpp_prefilter.find(name)) {
+          cpp_prefilter_skipped++;
+        } else {
+          if (std::optional<std::string_view> s = cpp_demangle(name))
+            name = *s;
+          if (std::optional<u32> idx = cpp_matcher.find(name))
+            match = std::min<i64>(match, *idx);
+        }
       }
 
       if (match != INT64_MAX)
@@ -1696,6 +2006,55 @@ void mark_addrsig(Context<E> &ctx) {
   });
 }
 
+// Decode relocations of live SHF_ALLOC sections for --relocation-cache.
+// Decoded relocations of each file are stored to a single contiguous
+// array, and raw relocations are copied to a parallel array, so that
+// the following passes, including scan_relocations and
+// apply_reloc_alloc, can walk them without touching mmap'ed input files.
+template <typename E>
+void decode_relocations(Context<E> &ctx) {
+  Timer t(ctx, "decode_relocations");
+  static Counter counter("decoded_relocs");
+
+  auto is_target = [](InputSection<E> *isec) {
+    return isec && isec->is_alive && (isec->shdr().sh_flags & SHF_ALLOC);
+  };
+
+  tbb::parallel_for_each(ctx.objs, [&](ObjectFile<E> *file) {
+    i64 size = 0;
+    for (InputSection<E> *isec : file->sections)
+      if (is_target(isec))
+        size += isec->get_rels(ctx).size();
+
+    file->decoded_rels.resize(size);
+    file->cached_rels.resize(size);
+    DecodedRel<E> *buf = file->decoded_rels.data();
+    ElfRel<E> *raw = file->cached_rels.data();
+
+    for (InputSection<E> *isec : file->sections) {
+      if (!is_target(isec))
+        continue;
+
+      std::span<ElfRel<E>> rels = isec->get_rels(ctx);
+      memcpy(raw, rels.data(), rels.size_bytes());
+
+      for (i64 i = 0; i < rels.size(); i++) {
+        const ElfRel<E> &rel = rels[i];
+        buf[i].sym = file->symbols[rel.r_sym];
+        buf[i].addend = get_addend(*isec, rel);
+        buf[i].r_offset = rel.r_offset;
+        buf[i].r_type = rel.r_type;
+      }
+
+      isec->decoded_rels = {buf, rels.size()};
+      buf += rels.size();
+      raw += rels.size();
+    }
+
+    counter += size;
+  });
+}
+
 template <typename E>
 void clear_padding(Context<E> &ctx) {
   Timer t(ctx, "clear_padding");
@@ -2218,7 +2577,7 @@ void compute_section_headers(Context<E> &ctx) {
     if (ctx.chunks[i]->kind() != HEADER)
       ctx.chunks[i]->shndx = shndx++;
 
-  if (ctx.symtab && SHN_LORESERVE <= shndx) {
+  if (ctx.symtab && !ctx.symtab_shndx && SHN_LORESERVE <= shndx) {
     SymtabShndxSection<E> *sec = new SymtabShndxSection<E>;
     sec->shndx = shndx++;
     sec->shdr.sh_link = ctx.symtab->shndx;
@@ -2512,6 +2871,213 @@ i64 compress_debug_sections(Context<E> &ctx) {
   return set_osec_offsets(ctx);
 }
 
+// --separate-debug-file moves non-allocated .debug_* sections from the
+// main output to a separate file and adds .gnu_debuglink to the main
+// output instead. This function updates the main output's layout.
+template <typename E>
+i64 separate_debug_sections(Context<E> &ctx) {
+  Timer t(ctx, "separate_debug_sections");
+
+  std::erase_if(ctx.chunks, [&](Chunk<E> *chunk) {
+    if (chunk->shdr.sh_flags & SHF_ALLOC)
+      return false;
+
+    std::string_view name = chunk->name;
+    if (name.starts_with(".debug")) {
+      ctx.debug_chunks.push_back(chunk);
+      return true;
+    }
+
+    // Relocation sections for debug sections created by --emit-relocs
+    // are dropped because their target sections are gone.
+    return name.starts_with(".rel.debug") || name.starts_with(".rela.debug");
+  });
+
+  ctx.gnu_debuglink = new GnuDebuglinkSection<E>;
+  ctx.chunk_pool.emplace_back(ctx.gnu_debuglink);
+
+  auto it = std::find(ctx.chunks.begin(), ctx.chunks.end(), ctx.shdr);
+  ctx.chunks.insert(it, ctx.gnu_debuglink);
+
+  compute_section_headers(ctx);
+
+  if (ctx.ehdr)
+    ctx.ehdr->update_shdr(ctx);
+  if (ctx.shdr)
+    ctx.shdr->update_shdr(ctx);
+
+  return set_osec_offsets(ctx);
+}
+
+// A separate debug file mirrors the main output's section headers so
+// that debuggers can map addresses to sections, but only the debug
+// sections and the build ID note have contents. That's the same file
+// layout as `objcopy --only-keep-debug` creates.
+template <typename E>
+struct DebugFileLayout {
+  std::vector<ElfShdr<E>> shdrs;
+  std::string shstrtab;
+  i64 buildid_shndx = 0;
+  i64 debug_shndx = 0;
+  i64 shstrtab_shndx = 0;
+  i64 shoff = 0;
+  i64 filesize = 0;
+};
+
+template <typename E>
+static DebugFileLayout<E> get_debug_file_layout(Context<E> &ctx) {
+  DebugFileLayout<E> layout;
+  std::vector<ElfShdr<E>> &shdrs = layout.shdrs;
+  i64 offset = sizeof(ElfEhdr<E>);
+
+  auto add_name = [&](std::string_view name) {
+    i64 off = layout.shstrtab.size();
+    layout.shstrtab += name;
+    layout.shstrtab += '\0';
+    return off;
+  };
+
+  auto add_contents = [&](ElfShdr<E> &shdr) {
+    offset = align_to(offset, std::max<i64>(shdr.sh_addralign, 1));
+    shdr.sh_offset = offset;
+    offset += shdr.sh_size;
+  };
+
+  add_name("");
+  shdrs.push_back({});
+
+  for (Chunk<E> *chunk : ctx.chunks) {
+    if (!chunk->shndx)
+      continue;
+
+    assert(chunk->shndx == shdrs.size());
+    ElfShdr<E> shdr = chunk->shdr;
+    shdr.sh_name = add_name(chunk->name);
+
+    if (chunk == ctx.buildid) {
+      layout.buildid_shndx = shdrs.size();
+      add_contents(shdr);
+    } else {
+      shdr.sh_type = SHT_NOBITS;
+      shdr.sh_offset = offset;
+    }
+    shdrs.push_back(shdr);
+  }
+
+  layout.debug_shndx = shdrs.size();
+
+  for (Chunk<E> *chunk : ctx.debug_chunks) {
+    ElfShdr<E> shdr = chunk->shdr;
+    shdr.sh_name = add_name(chunk->name);
+    add_contents(shdr);
+    shdrs.push_back(shdr);
+  }
+
+  layout.shstrtab_shndx = shdrs.size();
+
+  ElfShdr<E> shdr = {};
+  shdr.sh_name = add_name(".shstrtab");
+  shdr.sh_type = SHT_STRTAB;
+  shdr.sh_addralign = 1;
+  shdr.sh_size = layout.shstrtab.size();
+  add_contents(shdr);
+  shdrs.push_back(shdr);
+
+  // Large section numbers are stored to the null section header.
+  // See OutputEhdr::copy_buf for details.
+  if (UINT16_MAX < shdrs.size())
+    shdrs[0].sh_size = shdrs.size();
+  if (SHN_LORESERVE <= layout.shstrtab_shndx)
+    shdrs[0].sh_link = layout.shstrtab_shndx;
+
+  layout.shoff = align_to(offset, sizeof(Word<E>));
+  layout.filesize = layout.shoff + shdrs.size() * sizeof(ElfShdr<E>);
+  return layout;
+}
+
+// Creates a separate debug file and copies debug sections to it. This
+// is called in parallel with copy_chunks() for the main output.
+template <typename E>
+void write_separate_debug_file(Context<E> &ctx) {
+  Timer t(ctx, "write_separate_debug_file");
+
+  DebugFileLayout<E> layout = get_debug_file_layout(ctx);
+  ctx.debug_file = OutputFile<Context<E>>::open(ctx, ctx.arg.separate_debug_file,
+                                                layout.filesize, 0666);
+  u8 *buf = ctx.debug_file->buf;
+
+  tbb::parallel_for((i64)0, (i64)ctx.debug_chunks.size(), [&](i64 i) {
+    ElfShdr<E> &shdr = layout.shdrs[layout.debug_shndx + i];
+    ctx.debug_chunks[i]->write_to(ctx, buf + shdr.sh_offset);
+  });
+}
+
+// Computes a CRC32 in parallel by combining CRCs of fixed-size blocks.
+static u32 compute_crc32(u8 *buf, i64 size) {
+  constexpr i64 block_size = 1024 * 1024;
+  i64 nblocks = (size + block_size - 1) / block_size;
+  std::vector<u32> crcs(nblocks);
+
+  tbb::parallel_for((i64)0, nblocks, [&](i64 i) {
+    i64 len = std::min<i64>(block_size, size - i * block_size);
+    crcs[i] = crc32(0, buf + i * block_size, len);
+  });
+
+  u32 crc = crc32(0, nullptr, 0);
+  for (i64 i = 0; i < nblocks; i++) {
+    i64 len = std::min<i64>(block_size, size - i * block_size);
+    crc = crc32_combine(crc, crcs[i], len);
+  }
+  return crc;
+}
+
+// Writes the rest of the debug file, which includes a copy of the main
+// output's build ID, and then writes the debug file's CRC32 to the
+// main output's .gnu_debuglink. This must be called after the main
+// output's build ID is computed.
+template <typename E>
+void finish_separate_debug_file(Context<E> &ctx) {
+  Timer t(ctx, "finish_separate_debug_file");
+
+  DebugFileLayout<E> layout = get_debug_file_layout(ctx);
+  u8 *buf = ctx.debug_file->buf;
+
+  // Zero-clear paddings between sections
+  i64 pos = sizeof(ElfEhdr<E>);
+  for (ElfShdr<E> &shdr : layout.shdrs) {
+    if (shdr.sh_type == SHT_NOBITS || shdr.sh_size == 0)
+      continue;
+    memset(buf + pos, 0, shdr.sh_offset - pos);
+    pos = shdr.sh_offset + shdr.sh_size;
+  }
+  memset(buf + pos, 0, layout.shoff - pos);
+
+  // Copy the ELF header from the main output and fix it up.
+  ElfEhdr<E> &ehdr = *(ElfEhdr<E> *)buf;
+  memcpy(&ehdr, ctx.buf, sizeof(ehdr));
+  ehdr.e_phoff = 0;
+  ehdr.e_phentsize = 0;
+  ehdr.e_phnum = 0;
+  ehdr.e_shoff = layout.shoff;
+  ehdr.e_shentsize = sizeof(ElfShdr<E>);
+  ehdr.e_shnum = (layout.shdrs.size() <= UINT16_MAX) ? layout.shdrs.size() : 0;
+  ehdr.e_shstrndx = (layout.shstrtab_shndx < SHN_LORESERVE)
+    ? layout.shstrtab_shndx : (u16)SHN_XINDEX;
+
+  if (layout.buildid_shndx) {
+    ElfShdr<E> &shdr = layout.shdrs[layout.buildid_shndx];
+    memcpy(buf + shdr.sh_offset, ctx.buf + ctx.buildid->shdr.sh_offset,
+           shdr.sh_size);
+  }
+
+  memcpy(buf + layout.shdrs[layout.shstrtab_shndx].sh_offset,
+         layout.shstrtab.data(), layout.shstrtab.size());
+  write_vector(buf + layout.shoff, layout.shdrs);
+
+  ctx.gnu_debuglink->write_crc32(ctx, compute_crc32(buf, layout.filesize));
+  ctx.debug_file->close(ctx);
+}
+
 // Write Makefile-style dependency rules to a file specified by
 // --dependency-file. This is analogous to the compiler's -M flag.
 template <typename E>
@@ -2549,7 +3115,7 @@ void show_stats(Context<E> &ctx) {
     static Counter undefined("undefined_syms");
     undefined += obj->symbols.size() - obj->first_global;
 
-    for (std::unique_ptr<InputSection<E>> &sec : obj->sections) {
+    for (InputSection<E> *sec : obj->sections) {
       if (!sec || !sec->is_alive)
         continue;
 
@@ -2593,6 +3159,8 @@ void show_stats(Context<E> &ctx) {
   static Counter num_output_chunks("output_chunks", ctx.chunks.size());
   static Counter num_objs("num_objs", ctx.objs.size());
   static Counter num_dsos("num_dsos", ctx.dsos.size());
+  static Counter arena_bytes("arena_bytes", ctx.arena.get_size());
+  static Counter arena_capacity("arena_capacity", ctx.arena.get_capacity());
 
   if constexpr (needs_thunk<E>) {
     static Counter thunk_bytes("thunk_bytes");
@@ -2612,9 +3180,11 @@ using E = MOLD_TARGET;
 
 template void create_internal_file(Context<E> &);
 template void apply_exclude_libs(Context<E> &);
+template void intern_dso_symbols(Context<E> &);
 template void create_synthetic_sections(Context<E> &);
 template void resolve_symbols(Context<E> &);
 template void kill_eh_frame_sections(Context<E> &);
+template void discard_dead_object_debug_info(Context<E> &);
 template void resolve_section_pieces(Context<E> &);
 template void convert_common_symbols(Context<E> &);
 template void compute_merged_section_sizes(Context<E> &);
@@ -2632,20 +3202,26 @@ template void compute_section_sizes(Context<E> &);
 template void sort_output_sections(Context<E> &);
 template void claim_unresolved_symbols(Context<E> &);
 template void scan_relocations(Context<E> &);
+template void cluster_dynrel_sections(Context<E> &);
 template void report_undef_errors(Context<E> &);
 template void create_reloc_sections(Context<E> &);
 template void copy_chunks(Context<E> &);
+template SharedFile<E> *find_glibc_dt_relr_dso(Context<E> &);
 template void construct_relr(Context<E> &);
 template void create_output_symtab(Context<E> &);
 template void apply_version_script(Context<E> &);
 template void parse_symbol_version(Context<E> &);
 template void compute_import_export(Context<E> &);
 template void mark_addrsig(Context<E> &);
+template void decode_relocations(Context<E> &);
 template void clear_padding(Context<E> &);
 template void compute_section_headers(Context<E> &);
 template i64 set_osec_offsets(Context<E> &);
 template void fix_synthetic_symbols(Context<E> &);
 template i64 compress_debug_sections(Context<E> &);
+template i64 separate_debug_sections(Context<E> &);
+template void write_separate_debug_file(Context<E> &);
+template void finish_separate_debug_file(Context<E> &);
 template void write_dependency_file(Context<E> &);
 template void show_stats(Context<E> &);
 
@@ -147,8 +147,9 @@ template <typename E>
 static void scan_rels(Context<E> &ctx, InputSection<E> &isec,
                       RangeExtensionThunk<E> &thunk) {
   std::span<const ElfRel<E>> rels = isec.get_rels(ctx);
-  std::vector<RangeExtensionRef> &range_extn = isec.extra.range_extn;
-  range_extn.resize(rels.size());
+  std::span<RangeExtensionRef> &range_extn = isec.extra.range_extn;
+  if (range_extn.size() != rels.size())
+    range_extn = ctx.arena.template make_span<RangeExtensionRef>(rels.size());
 
   for (i64 i = 0; i < rels.size(); i++) {
     const ElfRel<E> &rel = rels[i];
@@ -0,0 +1,65 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -fPIC -shared -o $t/libfoo.so -xc -
+int foo = 3;
+int bar() { return 4; }
+EOF
+
+cat <<EOF | $CC -fPIC -c -o $t/a.o -xc -
+#include <stdio.h>
+extern int foo;
+int bar();
+int main() { printf("%d %d\n", foo, bar()); }
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o -L$t -lfoo -Wl,-rpath=$t -Wl,-z,now
+$QEMU $t/exe1 | grep -q '^3 4$'
+! readelf -WS $t/exe1 | grep -Fq .note.binding-cache || false
+
+$CC -B. -o $t/exe2 $t/a.o -L$t -lfoo -Wl,-rpath=$t -Wl,-z,now \
+  -Wl,--binding-cache
+$QEMU $t/exe2 | grep -q '^3 4$'
+
+readelf -WS $t/exe2 | grep -Fq .note.binding-cache
+readelf -Wn $t/exe2 | grep -A3 -F .note.binding-cache | grep -Fq mold
+
+# Decode the descriptor. It consists of a version, the number of DSOs,
+# the number of records, DSO soname offsets and 4-word records.
+read off size <<< $(readelf -WS $t/exe2 | sed 's/^.*\] //' | \
+  awk '$1 == ".note.binding-cache" { print $4, $5 }')
+
+endian=big
+readelf -h $t/exe2 | grep -Fq 'little endian' && endian=little
+note=($(od -An -v -tu4 --endian=$endian -j $((0x$off)) -N $((0x$size)) $t/exe2))
+
+readelf -p .dynstr $t/exe2 | \
+  sed -n 's/^ *\[ *\([0-9a-f]*\)\]  \(.*\)$/\1 \2/p' > $t/dynstr
+dynstr_offset() { printf '%d' 0x$(awk -v s="$1" '$2 == s { print $1 }' $t/dynstr); }
+dynsym_idx() {
+  readelf -W --dyn-syms $t/exe2 | awk -v s="$1" '$8 == s { print $1 }' | tr -d :
+}
+
+[ ${note[2]} = 1 ]                        # note type
+desc=("${note[@]:5}")
+[ ${desc[0]} = 1 ]                        # version
+num_dsos=${desc[1]}
+num_records=${desc[2]}
+[ $num_dsos = $(readelf -d $t/exe2 | grep -c NEEDED) ]
+[ ${#desc[@]} -ge $((3 + num_dsos + num_records * 4)) ]
+
+check_record() {
+  for i in $(seq 0 $((num_records - 1))); do
+    rec=("${desc[@]:$((3 + num_dsos + i * 4)):4}")
+    if [ ${rec[0]} = $(dynsym_idx $1) ]; then
+      [ ${desc[$((3 + rec[1]))]} = $(dynstr_offset libfoo.so) ]
+      [ ${rec[2]} = $(dynstr_offset $1) ]
+      [ ${rec[3]} = 0 ]
+      return
+    fi
+  done
+  false
+}
+
+check_record foo
+check_record bar
@@ -0,0 +1,29 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -c -o $t/a.o -xc -
+#include <stdio.h>
+char big[10 * 1024 * 1024] = {1};
+int main() { printf("Hello world %d\n", big[0]); }
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o -Wl,-build-id=fast
+$QEMU $t/exe1 | grep -q 'Hello world 1'
+readelf -n $t/exe1 | grep -q 'GNU.*0x00000010.*NT_GNU_BUILD_ID'
+
+# The ID does not depend on how chunks are scheduled
+$CC -B. -o $t/exe2 $t/a.o -Wl,-build-id=fast -Wl,-no-threads
+readelf -n $t/exe1 | grep 'Build ID' > $t/log1
+readelf -n $t/exe2 | grep 'Build ID' > $t/log2
+diff $t/log1 $t/log2
+
+$CC -B. -o $t/exe3 $t/a.o -Wl,-build-id=fast -Wl,-emit-relocs
+$CC -B. -o $t/exe4 $t/a.o -Wl,-build-id=fast -Wl,-emit-relocs -Wl,-no-threads
+readelf -n $t/exe3 | grep 'Build ID' > $t/log3
+readelf -n $t/exe4 | grep 'Build ID' > $t/log4
+diff $t/log3 $t/log4
+
+# Different contents give a different ID
+$CC -B. -o $t/exe5 $t/a.o -Wl,-build-id=fast -Wl,--defsym=foo=0x1234
+readelf -n $t/exe5 | grep 'Build ID' > $t/log5
+! diff $t/log1 $t/log5 >& /dev/null || false
@@ -0,0 +1,34 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -fPIC -c -o $t/a.o -xc -
+#include <stdio.h>
+
+__attribute__((section(".data.rel.ro.a"))) const char *const ptrs1[] = { "foo", "bar" };
+__attribute__((section(".data.rel.ro.b"))) const char buf1[8192] = {1};
+__attribute__((section(".data.rel.ro.c"))) const char *const ptrs2[] = { "baz", "qux" };
+__attribute__((section(".data.rel.ro.d"))) const char buf2[8192] = {2};
+__attribute__((section(".data.rel.ro.e"))) const char *const ptrs3[] = { "quux" };
+
+int main() {
+  printf("%s %s %s %s %s %d %d\n", ptrs1[0], ptrs1[1], ptrs2[0], ptrs2[1],
+         ptrs3[0], buf1[0], buf2[0]);
+}
+EOF
+
+get_addr() { nm $1 | grep -w $2 | cut -d' ' -f1; }
+
+$CC -B. -pie -o $t/exe1 $t/a.o
+$QEMU $t/exe1 | grep -q 'foo bar baz qux quux 1 2'
+[ $((0x$(get_addr $t/exe1 ptrs2))) -gt $((0x$(get_addr $t/exe1 buf1))) ]
+
+$CC -B. -pie -o $t/exe2 $t/a.o -Wl,--cluster-dynrels
+$QEMU $t/exe2 | grep -q 'foo bar baz qux quux 1 2'
+
+# Sections with dynamic relocations are placed before ones without them
+[ $((0x$(get_addr $t/exe2 ptrs1))) -lt $((0x$(get_addr $t/exe2 buf1))) ]
+[ $((0x$(get_addr $t/exe2 ptrs2))) -lt $((0x$(get_addr $t/exe2 buf1))) ]
+[ $((0x$(get_addr $t/exe2 ptrs3))) -lt $((0x$(get_addr $t/exe2 buf1))) ]
+
+# Sections without dynamic relocations keep their relative order
+[ $((0x$(get_addr $t/exe2 buf1))) -lt $((0x$(get_addr $t/exe2 buf2))) ]
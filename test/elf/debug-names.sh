@@ -0,0 +1,132 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = x86_64 ] || skip
+command -v llvm-dwarfdump >& /dev/null || skip
+test_cflags -gdwarf-5 -ggnu-pubnames || skip
+
+cat <<EOF | $CXX -c -o $t/a.o -xc++ -g -gdwarf-5 -ggnu-pubnames -
+namespace ns {
+struct Foo { int x; };
+int bar(Foo *p) { return p->x; }
+}
+
+int baz(int x) { return x + 1; }
+EOF
+
+cat <<EOF | $CXX -c -o $t/b.o -xc++ -g -gdwarf-5 -ggnu-pubnames -
+#include <stdio.h>
+
+namespace ns {
+struct Foo { int x; };
+int bar(Foo *p);
+}
+
+int baz(int x);
+int qux = 3;
+
+int main() {
+  ns::Foo foo{qux};
+  printf("%d\n", ns::bar(&foo) + baz(2));
+}
+EOF
+
+# A compunit with its own .debug_names, as Clang creates with -gpubnames
+cat <<'EOF' | $CC -c -o $t/c.o -xassembler -
+.section .debug_abbrev,"",@progbits
+.uleb128 1
+.uleb128 0x11        # DW_TAG_compile_unit
+.byte 1
+.uleb128 0x03        # DW_AT_name
+.uleb128 0x0e        # DW_FORM_strp
+.byte 0, 0
+.uleb128 2
+.uleb128 0x2e        # DW_TAG_subprogram
+.byte 0
+.uleb128 0x03        # DW_AT_name
+.uleb128 0x0e        # DW_FORM_strp
+.byte 0, 0
+.byte 0
+
+.section .debug_info,"",@progbits
+.Lcu:
+.long .Lcu_end - .Lcu - 4
+.short 5
+.byte 1              # DW_UT_compile
+.byte 8
+.long .debug_abbrev
+.uleb128 1
+.long .Lstr_cu
+.Ldie:
+.uleb128 2
+.long .Lstr_fn
+.byte 0
+.Lcu_end:
+
+.section .debug_str,"MS",@progbits,1
+.Lstr_cu:
+.asciz "c.c"
+.Lstr_fn:
+.asciz "hello_from_names"
+
+.section .debug_names,"",@progbits
+.long .Lnames_end - .Lnames_start
+.Lnames_start:
+.short 5, 0
+.long 1, 0, 0, 1, 1
+.long .Labbrev_end - .Labbrev
+.long 0
+.long .Lcu           # CU list
+.long 1              # buckets
+.long 0xe8fd3c7f     # hashes
+.long .Lstr_fn       # string offsets
+.long 0              # entry offsets
+.Labbrev:
+.uleb128 1
+.uleb128 0x2e        # DW_TAG_subprogram
+.uleb128 3           # DW_IDX_die_offset
+.uleb128 0x13        # DW_FORM_ref4
+.byte 0, 0
+.byte 0
+.Labbrev_end:
+.uleb128 1
+.long .Ldie - .Lcu
+.byte 0
+.Lnames_end:
+EOF
+
+# A compunit without any name index must not be listed in the CU list
+cat <<EOF | $CC -c -o $t/d.o -xc -g -gdwarf-5 -
+int only_in_d(int x) { return x * 2; }
+EOF
+
+$CXX -B. -o $t/exe $t/a.o $t/b.o $t/c.o $t/d.o -Wl,--debug-names
+$QEMU $t/exe | grep -q '^6$'
+
+readelf -WS $t/exe > $t/log
+grep -Fq .debug_names $t/log
+! grep -Fq .debug_gnu_pubnames $t/log || false
+
+llvm-dwarfdump --debug-names $t/exe > $t/log2
+[ "$(grep -c 'Name Index @' $t/log2)" = 1 ]
+grep -Fq 'CU count: 3' $t/log2
+grep -Fq '"bar"' $t/log2
+grep -Fq '"baz"' $t/log2
+grep -Fq '"main"' $t/log2
+grep -Fq '"qux"' $t/log2
+grep -Fq '"Foo"' $t/log2
+grep -Fq '"ns"' $t/log2
+grep -Fq '"hello_from_names"' $t/log2
+! grep -Fq '"ns::bar' $t/log2 || false
+! grep -Fq '"only_in_d"' $t/log2 || false
+
+# Pubnames don't have linkage names, so the verifier complains about
+# them, but it must not complain about the unlisted compunit.
+llvm-dwarfdump --verify --debug-names $t/exe > $t/log3 2>&1 || true
+grep -q 'not covered by any Name Index' $t/log3
+! grep -Fq only_in_d $t/log3 || false
+
+# --find looks up names using the index
+llvm-dwarfdump --find=baz $t/exe | grep -q DW_TAG_subprogram
+llvm-dwarfdump --find=Foo $t/exe | grep -q DW_TAG_structure_type
+llvm-dwarfdump --find=hello_from_names $t/exe | grep -q DW_TAG_subprogram
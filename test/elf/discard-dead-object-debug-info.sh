@@ -0,0 +1,36 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = $HOST ] || skip
+
+cat <<EOF | $CC -c -o $t/a.o -xc -g -ffunction-sections -
+#include <stdio.h>
+int main() {
+  printf("Hello world\n");
+}
+EOF
+
+cat <<EOF | $CC -c -o $t/b.o -xc -g -ffunction-sections -fdata-sections -
+int unused_var_in_dead_file = 3;
+int unused_fn_in_dead_file(void) { return unused_var_in_dead_file; }
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o -Wl,--gc-sections
+$QEMU $t/exe1 | grep -q 'Hello world'
+readelf --debug-dump=info $t/exe1 > $t/log1
+grep -Fq unused_fn_in_dead_file $t/log1
+grep -Fq main $t/log1
+readelf -p .debug_str $t/exe1 | grep -Fq unused_fn_in_dead_file
+
+$CC -B. -o $t/exe2 $t/a.o $t/b.o -Wl,--gc-sections \
+  -Wl,--discard-dead-object-debug-info
+$QEMU $t/exe2 | grep -q 'Hello world'
+readelf --debug-dump=info $t/exe2 > $t/log2
+! grep -Fq unused_fn_in_dead_file $t/log2 || false
+grep -Fq main $t/log2
+
+# Strings only used by the removed debug info are removed too
+readelf -p .debug_str $t/exe2 > $t/log3
+! grep -Fq unused_fn_in_dead_file $t/log3 || false
+! grep -Fq unused_var_in_dead_file $t/log3 || false
+grep -Fq 'GNU C' $t/log3
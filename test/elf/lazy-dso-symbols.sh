@@ -0,0 +1,54 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = ppc64 ] && skip
+[ $MACHINE = ppc64le ] && skip
+[ $MACHINE = alpha ] && skip
+
+cat <<EOF > $t/a.ver
+VER1 { foo; };
+VER2 { foo; };
+EOF
+
+cat <<EOF | $CC -fPIC -c -o $t/a.o -xc -
+int foo1() { return 1; }
+int foo2() { return 2; }
+__asm__(".symver foo1, foo@VER1");
+__asm__(".symver foo2, foo@@VER2");
+
+int bar = 3;
+extern int bar_alias __attribute__((alias("bar")));
+int bar_get() { return bar_alias; }
+int unused1() { return 4; }
+int unused2() { return 5; }
+EOF
+
+$CC -B. -shared -o $t/a.so $t/a.o -Wl,--version-script=$t/a.ver
+
+cat <<EOF | $CC -fno-PIE -c -o $t/b.o -xc -
+#include <stdio.h>
+int foo();
+int old_foo();
+__asm__(".symver old_foo, foo@VER1");
+extern int bar;
+int bar_get();
+
+int main() {
+  bar = 10;
+  printf("%d %d %d\n", foo(), old_foo(), bar_get());
+}
+EOF
+
+$CC -B. -o $t/exe1 $t/b.o $t/a.so -no-pie -Wl,--lazy-dso-symbols
+$QEMU $t/exe1 | grep -q '^2 1 10$'
+
+readelf --dyn-syms $t/exe1 > $t/log1
+grep -Fq bar_alias $t/log1
+! grep -Fq unused1 $t/log1 || false
+
+$CC -B. -o $t/exe2 $t/b.o $t/a.so -no-pie
+readelf --dyn-syms $t/exe2 > $t/log2
+diff $t/log1 $t/log2
+
+$CC -B. -o $t/exe3 $t/b.o $t/a.so -no-pie -Wl,--lazy-dso-symbols -Wl,--gc-sections
+$QEMU $t/exe3 | grep -q '^2 1 10$'
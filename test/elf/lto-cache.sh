@@ -0,0 +1,26 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+echo 'int main() {}' | $GCC -flto -o /dev/null -xc - >& /dev/null \
+  || skip
+
+cat <<EOF | $GCC -flto -c -o $t/a.o -xc -
+#include <stdio.h>
+int main() {
+  printf("Hello world\n");
+}
+EOF
+
+rm -rf $t/cache
+$GCC -B. -o $t/exe1 -flto $t/a.o -Wl,--lto-cache-dir=$t/cache
+$QEMU $t/exe1 | grep -q 'Hello world'
+[ "$(ls $t/cache | wc -l)" -eq 1 ] || false
+
+$GCC -B. -o $t/exe2 -flto $t/a.o -Wl,--lto-cache-dir=$t/cache
+$QEMU $t/exe2 | grep -q 'Hello world'
+[ "$(ls $t/cache | wc -l)" -eq 1 ] || false
+
+# Different code generation options create a new cache entry.
+$GCC -B. -o $t/exe3 -flto -O2 $t/a.o -Wl,--lto-cache-dir=$t/cache
+$QEMU $t/exe3 | grep -q 'Hello world'
+[ "$(ls $t/cache | wc -l)" -eq 2 ] || false
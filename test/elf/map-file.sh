@@ -0,0 +1,16 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -o $t/a.o -c -ffunction-sections -xc -
+int foo() { return 3; }
+int main() { return foo(); }
+EOF
+
+$CC -B. -o $t/exe $t/a.o -Wl,-Map=$t/map
+grep -Eq '^ +0x[0-9a-f]+ +[0-9]+ +[0-9]+ \.text$' $t/map
+grep -q 'a.o:(.text.foo)' $t/map
+grep -Eq '^ +0x[0-9a-f]+ +0 +0 +foo$' $t/map
+
+$CC -B. -o $t/exe $t/a.o -Wl,-Map=$t/map.json -Wl,--map-format=json
+grep -q '"output_sections":\[' $t/map.json
+grep -q '"name":".text.foo",.*"symbols":\[{"name":"foo","addr":[0-9]*}\]' $t/map.json
@@ -0,0 +1,35 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = m68k ] && skip
+[ $MACHINE = ppc ] && skip
+
+cat <<EOF | $CC -o $t/a.o -fPIC -c -xc -
+#include <stdio.h>
+static int x, y, z;
+int *ptrs[] = { &x, &y, &z };
+
+int main() {
+  *ptrs[1] = 3;
+  printf("Hello world %d\n", y);
+}
+EOF
+
+$CC -B. -o $t/exe -pie $t/a.o -Wl,--pack-dyn-relocs=auto -Wl,--stats > $t/log1
+$QEMU $t/exe | grep -q 'Hello world 3'
+readelf --dynamic $t/exe > $t/log2
+
+if readelf -V $($CC -print-file-name=libc.so.6) 2> /dev/null |
+   grep -q GLIBC_ABI_DT_RELR; then
+  grep -wq RELR $t/log2
+  readelf -V $t/exe | grep -q GLIBC_ABI_DT_RELR
+  grep -q relr_relocs $t/log1
+  grep -q relr_saved_bytes $t/log1
+else
+  ! grep -wq RELR $t/log2 || false
+fi
+
+# Never enabled for position-dependent executables
+$CC -B. -o $t/exe2 -no-pie $t/a.o -Wl,--pack-dyn-relocs=auto
+$QEMU $t/exe2 | grep -q 'Hello world 3'
+! readelf --dynamic $t/exe2 | grep -wq RELR || false
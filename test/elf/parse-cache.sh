@@ -0,0 +1,28 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -o $t/a.o -c -xc -
+#include <stdio.h>
+void hello() { printf("Hello world\n"); }
+EOF
+
+cat <<EOF | $CC -o $t/b.o -c -xc -
+#include <stdio.h>
+void hello();
+int main() { printf("Hello world\n"); hello(); }
+EOF
+
+rm -rf $t/cache
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o -Wl,--parse-cache=$t/cache -Wl,--stats > $t/log1
+[ "$(ls $t/cache | wc -l)" -gt 0 ] || false
+$QEMU $t/exe1 | grep -q 'Hello world'
+grep -Eq 'parse_cache_misses=[1-9]' $t/log1
+grep -Eq 'parse_cache_hits=0$' $t/log1
+
+$CC -B. -o $t/exe2 $t/a.o $t/b.o -Wl,--parse-cache=$t/cache -Wl,--stats > $t/log2
+grep -Eq 'parse_cache_hits=[1-9]' $t/log2
+grep -Eq 'parse_cache_misses=0$' $t/log2
+
+$CC -B. -o $t/exe3 $t/a.o $t/b.o
+cmp $t/exe2 $t/exe3
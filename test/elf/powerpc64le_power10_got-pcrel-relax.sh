@@ -0,0 +1,49 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = ppc64le ] || skip
+[[ "$CC" = *power10* ]] || skip
+
+cat <<EOF | $CC -c -o $t/a.o -xassembler -
+.globl get_foo, get_bar
+.type get_foo, @function
+.type get_bar, @function
+
+get_foo:
+  .localentry get_foo, 1
+  pld 3, foo@got@pcrel
+  lwz 3, 0(3)
+  blr
+
+get_bar:
+  .localentry get_bar, 1
+  pld 9, bar@got@pcrel
+.Lpcrel0:
+  .reloc .Lpcrel0-8, R_PPC64_PCREL_OPT, .-(.Lpcrel0-8)
+  lwz 3, 4(9)
+  blr
+EOF
+
+cat <<EOF | $CC -c -o $t/b.o -fPIC -xc -
+#include <stdio.h>
+
+int foo = 42;
+int bar[] = {1, 7};
+int get_foo();
+int get_bar();
+
+int main() {
+  printf("%d\n", get_foo() + get_bar());
+}
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o
+$QEMU $t/exe1 | grep -q '^49$'
+$OBJDUMP -d $t/exe1 | grep -A3 -E '<get_(foo|bar)>:' > $t/log1
+grep -A3 '<get_foo>:' $t/log1 | grep -Eq 'pla|paddi'
+grep -A3 '<get_bar>:' $t/log1 | grep -q plwz
+! grep -Eq '\spld\s' $t/log1 || false
+
+$CC -B. -o $t/exe2 $t/a.o $t/b.o -Wl,--no-relax
+$QEMU $t/exe2 | grep -q '^49$'
+$OBJDUMP -d $t/exe2 | grep -A3 '<get_foo>:' | grep -Eq '\spld\s'
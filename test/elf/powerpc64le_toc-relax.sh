@@ -0,0 +1,40 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = ppc64le ] || skip
+
+cat <<EOF | $CC -c -o $t/a.o -xassembler -
+.globl get_foo
+.type get_foo, @function
+get_foo:
+  addis 3, 2, .LC0@toc@ha
+  ld 3, .LC0@toc@l(3)
+  lwz 3, 0(3)
+  blr
+
+.section .toc, "aw"
+.LC0:
+  .quad foo
+EOF
+
+cat <<EOF | $CC -c -o $t/b.o -fPIC -xc -
+#include <stdio.h>
+
+int foo = 42;
+int get_foo();
+
+int main() {
+  printf("%d\n", get_foo());
+}
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o
+$QEMU $t/exe1 | grep -q '^42$'
+$OBJDUMP -d $t/exe1 | grep -A3 '<get_foo>:' > $t/log1
+grep -Eq 'addi\s+r3,r3,' $t/log1
+! grep -Eq '\sld\s' $t/log1 || false
+
+$CC -B. -o $t/exe2 $t/a.o $t/b.o -Wl,--no-relax
+$QEMU $t/exe2 | grep -q '^42$'
+$OBJDUMP -d $t/exe2 | grep -A3 '<get_foo>:' > $t/log2
+grep -Eq '\sld\s' $t/log2
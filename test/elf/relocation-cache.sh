@@ -0,0 +1,45 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+# See icf.sh for why this test is skipped on PPC64V1.
+[ $MACHINE = ppc64 ] && skip
+
+cat <<EOF | $CC -c -o $t/a.o -ffunction-sections -fdata-sections -xc -
+#include <stdio.h>
+
+int bar() {
+  return 5;
+}
+
+int foo1(int x) {
+  return bar() + x;
+}
+
+int foo2(int x) {
+  return bar() + x;
+}
+
+int foo3() {
+  bar();
+  return 5;
+}
+
+int unused() {
+  return bar() + 42;
+}
+
+int main() {
+  printf("%d %d\n", (long)foo1 == (long)foo2, (long)foo1 == (long)foo3);
+  return 0;
+}
+EOF
+
+$CC -B. -o $t/exe $t/a.o -Wl,-icf=all -Wl,-gc-sections -Wl,-relocation-cache \
+  -Wl,-print-gc-sections > $t/log
+$QEMU $t/exe | grep -q '1 0'
+grep -q 'removing unused section .*:(.text.unused)' $t/log
+
+# Relocations are scanned and applied using the cached copies, and the
+# result must be the same as without the cache.
+$CC -B. -o $t/exe2 $t/a.o -Wl,-icf=all -Wl,-gc-sections
+cmp $t/exe $t/exe2
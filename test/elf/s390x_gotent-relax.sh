@@ -0,0 +1,49 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = s390x ] || skip
+
+cat <<EOF | $CC -c -o $t/a.o -fPIC -xassembler -
+.globl get_foo, get_bar
+.type get_foo, @function
+.type get_bar, @function
+
+get_foo:
+  lgrl %r2, foo@GOTENT
+  lgf %r2, 0(%r2)
+  br %r14
+
+get_bar:
+  lgrl %r2, bar@GOTENT
+  llgc %r2, 0(%r2)
+  br %r14
+
+.data
+.byte 0
+bar:
+.byte 7
+EOF
+
+cat <<EOF | $CC -c -o $t/b.o -fPIC -xc -
+#include <stdio.h>
+
+int foo = 42;
+int get_foo();
+int get_bar();
+
+int main() {
+  printf("%d %d\n", get_foo(), get_bar());
+}
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o
+$QEMU $t/exe1 | grep -q '^42 7$'
+$OBJDUMP -d $t/exe1 > $t/log1
+grep -A1 '<get_foo>:' $t/log1 | grep -q larl
+
+# bar is at an odd address, so it can't be relaxed
+grep -A1 '<get_bar>:' $t/log1 | grep -q lgrl
+
+$CC -B. -o $t/exe2 $t/a.o $t/b.o -Wl,--no-relax
+$QEMU $t/exe2 | grep -q '^42 7$'
+$OBJDUMP -d $t/exe2 | grep -A1 '<get_foo>:' | grep -q lgrl
@@ -0,0 +1,37 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -c -g -o $t/a.o -xc -
+#include <stdio.h>
+
+int main() {
+  printf("Hello world\n");
+  return 0;
+}
+EOF
+
+$CC -B. -o $t/exe $t/a.o -Wl,--separate-debug-file -Wl,--build-id
+$QEMU $t/exe | grep -q 'Hello world'
+
+readelf --sections $t/exe > $t/log1
+! grep -Fq .debug_info $t/log1 || false
+grep -Fq .gnu_debuglink $t/log1
+
+readelf --sections $t/exe.dbg > $t/log2
+grep -Fq .debug_info $t/log2
+
+readelf --string-dump=.gnu_debuglink $t/exe | grep -Fq exe.dbg
+
+readelf --notes $t/exe | grep 'Build ID' > $t/log3
+readelf --notes $t/exe.dbg | grep 'Build ID' > $t/log4
+diff $t/log3 $t/log4
+
+$CC -B. -o $t/exe2 $t/a.o -Wl,--separate-debug-file=$t/foo.debug
+[ -f $t/foo.debug ]
+readelf --string-dump=.gnu_debuglink $t/exe2 | grep -Fq foo.debug
+
+$CC -B. -o $t/exe3 $t/a.o -Wl,--separate-debug-file -Wl,--build-id=sha1
+$QEMU $t/exe3 | grep -q 'Hello world'
+readelf --notes $t/exe3 | grep 'Build ID' > $t/log5
+readelf --notes $t/exe3.dbg | grep 'Build ID' > $t/log6
+diff $t/log5 $t/log6
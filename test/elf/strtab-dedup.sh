@@ -0,0 +1,43 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<EOF | $CC -o $t/a.o -c -xc -
+static int some_long_helper_name() { return 1; }
+int foo() { return some_long_helper_name(); }
+int long_helper_name() { return 3; }
+EOF
+
+cat <<EOF | $CC -o $t/b.o -c -xc -
+static int some_long_helper_name() { return 2; }
+int bar() { return some_long_helper_name(); }
+EOF
+
+cat <<EOF | $CC -o $t/c.o -c -xc -
+#include <stdio.h>
+int foo();
+int bar();
+int main() { printf("%d %d\n", foo(), bar()); }
+EOF
+
+$CC -B. -o $t/exe1 $t/a.o $t/b.o $t/c.o
+$CC -B. -o $t/exe2 $t/a.o $t/b.o $t/c.o -Wl,--strtab-dedup
+$CC -B. -o $t/exe3 $t/a.o $t/b.o $t/c.o -Wl,--strtab-dedup=suffix
+
+$QEMU $t/exe2 | grep -q '^1 2$'
+$QEMU $t/exe3 | grep -q '^1 2$'
+
+readelf --symbols $t/exe2 > $t/log2
+[ "$(grep -c ' some_long_helper_name$' $t/log2)" -eq 2 ]
+grep -q ' long_helper_name$' $t/log2
+
+readelf --symbols $t/exe3 > $t/log3
+[ "$(grep -c ' some_long_helper_name$' $t/log3)" -eq 2 ]
+grep -q ' long_helper_name$' $t/log3
+
+get_size() {
+  readelf --wide --sections $1 | \
+    sed -n 's/.* \.strtab *STRTAB *[0-9a-f]* [0-9a-f]* \([0-9a-f]*\) .*/0x\1/p'
+}
+
+[ $(($(get_size $t/exe2))) -lt $(($(get_size $t/exe1))) ]
+[ $(($(get_size $t/exe3))) -lt $(($(get_size $t/exe2))) ]
@@ -0,0 +1,38 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<'EOF' > $t/a.ver
+VER1 { extern "C++" { ns::*; }; };
+VER2 { extern "C++" { "other::foo(ns::Foo)"; }; };
+VER3 { local: *; };
+EOF
+
+cat <<EOF | $CXX -fPIC -c -o $t/b.o -xc++ -
+namespace ns {
+struct Foo { int x; };
+int foo(Foo f) { return f.x; }
+}
+namespace other {
+int foo(ns::Foo f) { return f.x; }
+int bar(ns::Foo f) { return f.x; }
+}
+EOF
+
+$CC -B. -shared -Wl,--version-script=$t/a.ver -o $t/c.so $t/b.o
+
+readelf --wide --dyn-syms $t/c.so > $t/log
+grep -q '_ZN2ns3fooENS_3FooE@@VER1' $t/log
+grep -q '_ZN5other3fooEN2ns3FooE@@VER2' $t/log
+! grep -q '_ZN5other3barEN2ns3FooE' $t/log || false
+
+cat <<'EOF' > $t/d.ver
+VER1 { extern "C++" { std::foo*; }; };
+VER2 { local: *; };
+EOF
+
+cat <<EOF | $CXX -fPIC -c -o $t/e.o -xc++ -
+namespace std { int foo() { return 3; } }
+EOF
+
+$CC -B. -shared -Wl,--version-script=$t/d.ver -o $t/f.so $t/e.o
+readelf --wide --dyn-syms $t/f.so | grep -q '_ZSt3foov@@VER1'
@@ -0,0 +1,27 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+cat <<'EOF' > $t/a.ver
+VER1 { foo*bar*; };
+VER2 { f?o[0-9]*; *baz*qux; };
+VER3 { local: *; };
+EOF
+
+cat <<EOF | $CC -fPIC -c -o $t/b.o -xc -
+void foo_bar() {}
+void foo1() {}
+void fxo2_bar() {}
+void foo1bar() {}
+void abazqux() {}
+void bazquux() {}
+EOF
+
+$CC -B. -shared -Wl,--version-script=$t/a.ver -o $t/c.so $t/b.o
+
+readelf --wide --dyn-syms $t/c.so > $t/log
+grep -q ' foo_bar@@VER1' $t/log
+grep -q ' foo1@@VER2' $t/log
+grep -q ' fxo2_bar@@VER2' $t/log
+grep -q ' abazqux@@VER2' $t/log
+grep -q ' foo1bar@@VER1' $t/log
+! grep -q ' bazquux' $t/log || false
@@ -0,0 +1,50 @@
+#!/bin/bash
+. $(dirname $0)/common.inc
+
+[ $MACHINE = x86_64 ] || skip
+
+cat <<EOF | $CC -fPIC -shared -o $t/a.so -xc -
+#include <stdio.h>
+void hello() { printf("Hello "); }
+void world() { printf("world\n"); }
+EOF
+
+cat <<EOF | $CC -fno-PIC -c -o $t/b.o -xc -
+void hello();
+void world();
+int main() {
+  hello();
+  world();
+}
+EOF
+
+$CC -B. -no-pie -o $t/exe1 $t/b.o $t/a.so -Wl,-z,now
+$QEMU $t/exe1 | grep -q 'Hello world'
+
+# No lazy PLT, and .plt.got entries are 8 bytes long
+readelf -WS $t/exe1 > $t/log1
+! grep -Eq ' \.plt ' $t/log1 || false
+grep -Eq '\.plt\.got +PROGBITS +[0-9a-f]+ [0-9a-f]+ 0+10 ' $t/log1
+
+# .plt.got entries must start with endbr64 if IBT is enabled
+$CC -B. -no-pie -o $t/exe2 $t/b.o $t/a.so -Wl,-z,now -Wl,-z,ibt
+$QEMU $t/exe2 | grep -q 'Hello world'
+readelf -WS $t/exe2 | grep -Eq '\.plt\.got +PROGBITS +[0-9a-f]+ [0-9a-f]+ 0+20 '
+
+# Indirect calls and jumps via GOT are relaxed to direct ones
+cat <<EOF | $CC -o $t/c.o -c -x assembler -Wa,-mrelax-relocations=yes -
+.globl bar
+bar:
+  call *foo@GOTPCREL(%rip)
+  jmp  *foo@GOTPCREL(%rip)
+EOF
+
+cat <<EOF | $CC -o $t/d.o -c -xc -
+void foo() {}
+int main() { return 0; }
+EOF
+
+$CC -B. -o $t/exe3 $t/c.o $t/d.o
+$OBJDUMP -d $t/exe3 | grep -A4 '<bar>:' > $t/log3
+grep -Eq 'addr32 call.*<foo>' $t/log3
+grep -Eq 'jmp.*<foo>' $t/log3